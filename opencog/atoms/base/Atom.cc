@@ -51,7 +51,8 @@ std::weak_ptr<Atom> hashable_weak_ptr<Atom>::_dummy = std::weak_ptr<Atom>();
 #endif
 
 #if USE_MUTEX_POOL
-Atom::MutexPool Atom::_mutex_pool;
+Atom::MutexPool Atom::_inset_mutex_pool;
+Atom::MutexPool Atom::_kvp_mutex_pool;
 #endif
 
 Atom::~Atom()
@@ -100,6 +101,7 @@ void Atom::setValue(const Handle& key, const ValuePtr& value)
 			_values[truth_key()] = value;
 		else
 			_values.erase(truth_key());
+		sync_values_flag();
 	}
 	else
 	{
@@ -108,6 +110,7 @@ void Atom::setValue(const Handle& key, const ValuePtr& value)
 			_values[key] = value;
 		else
 			_values.erase(key);
+		sync_values_flag();
 	}
 }
 
@@ -124,6 +127,12 @@ ValuePtr Atom::getValue(const Handle& key) const
     // the multi-threaded async atom store in the SQL peristance backend.
     // Furthermore, we must make a copy while holding the lock! Got that?
 
+    // Lock-free fast path: about half of all Atoms have no Values on
+    // them at all. The flag is changed only while holding the lock,
+    // after the change to the map; seeing it clear means that we ran
+    // before any Value was set.
+    if (not (_flags.load() & HAVE_VALUES_FLAG)) return ValuePtr();
+
     // This is rather irritating, but we fake it for the
     // PredicateNode "*-TruthValueKey-*" because if we don't
     // then load-from-file and load-from-network breaks.
@@ -143,6 +152,22 @@ ValuePtr Atom::getValue(const Handle& key) const
     return ValuePtr();
 }
 
+/// If the only reference to the FloatValue `pap` is the one in the
+/// KVP map, then no one else can see it, and it can be updated in
+/// place, without making a new one. Anyone who got hold of it earlier
+/// keeps a reference, and so sees the old counts, unchanged; and no
+/// one can grab it while we hold the lock, because all copies out of
+/// the map are made while holding the lock.
+///
+/// Derived types (the streams, etc.) compute their own contents, so
+/// only plain FloatValues qualify.
+static inline FloatValue* in_place(const ValuePtr& pap)
+{
+	if (FLOAT_VALUE != pap->get_type() or 1 != pap.use_count())
+		return nullptr;
+	return static_cast<FloatValue*>(pap.get());
+}
+
 ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& count)
 {
 	KVP_UNIQUE_LOCK;
@@ -151,6 +176,15 @@ ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& coun
 	auto pr = _values.find(key);
 	if (_values.end() != pr)
 	{
+		// The increment loop in the counting pipelines goes
+		// through here. Avoid making a new Value, if possible.
+		FloatValue* fip = in_place(pr->second);
+		if (fip)
+		{
+			fip->add_in_place(count);
+			return pr->second;
+		}
+
 		ValuePtr pap = pr->second;
 
 		// Its not a float. Do nothing.
@@ -170,6 +204,7 @@ ValuePtr Atom::incrementCount(const Handle& key, const std::vector<double>& coun
 	ValuePtr nv = createFloatValue(count);
 
 	_values[key] = nv;
+	_flags.fetch_or(HAVE_VALUES_FLAG);
 	return nv;
 }
 
@@ -182,6 +217,13 @@ ValuePtr Atom::incrementCount(const Handle& key, size_t idx, double count)
 	auto pr = _values.find(key);
 	if (_values.end() != pr)
 	{
+		FloatValue* fip = in_place(pr->second);
+		if (fip)
+		{
+			fip->add_in_place(idx, count);
+			return pr->second;
+		}
+
 		ValuePtr pap = pr->second;
 
 		// Its not a float. Do nothing.
@@ -206,12 +248,14 @@ ValuePtr Atom::incrementCount(const Handle& key, size_t idx, double count)
 	ValuePtr nv = createFloatValue(new_vect);
 
 	_values[key] = nv;
+	_flags.fetch_or(HAVE_VALUES_FLAG);
 	return nv;
 }
 
 HandleSet Atom::getKeys() const
 {
     HandleSet keyset;
+    if (not haveValues()) return keyset;
     KVP_SHARED_LOCK;
     for (const auto& pr : _values)
         keyset.insert(pr.first);
@@ -240,6 +284,7 @@ void Atom::copyValues(const Handle& other)
 	if (_values.empty())
 	{
 		_values.swap(vcpy);
+		sync_values_flag();
 		return;
 	}
 
@@ -248,6 +293,7 @@ void Atom::copyValues(const Handle& other)
 	// but the insert_or_assign is slightly faster.
 	for (const auto& pr : vcpy)
 		_values.insert_or_assign(std::move(pr.first), std::move(pr.second));
+	sync_values_flag();
 }
 
 void Atom::bulkCopyValues(const Handle& other)
@@ -256,12 +302,14 @@ void Atom::bulkCopyValues(const Handle& other)
 	// and thus the same lock protects `other` as well as `this`.
 	KVP_UNIQUE_LOCK;
 	_values = other->_values;
+	sync_values_flag();
 }
 
 void Atom::clearValues(void)
 {
     KVP_UNIQUE_LOCK;
     _values.clear();
+    sync_values_flag();
 }
 
 /**
@@ -336,6 +384,7 @@ bool Atom::setAbsent(void)
 {
     KVP_UNIQUE_LOCK;
     _values.clear();
+    sync_values_flag();
     uint8_t old_flags = _flags.fetch_or(ABSENT_FLAG);
     return old_flags & ABSENT_FLAG;
 }
@@ -462,19 +511,19 @@ void Atom::insert_atom(const Handle& a)
     if (not (_flags.load() & USE_ISET_FLAG)) return;
     INCOMING_UNIQUE_LOCK;
 
-    Type at = a->get_type();
+    get_inset_map().insert(a->get_type(), GET_PTR(a));
+}
+
+/// Add many atoms to the incoming set, taking the lock just once.
+/// Used for bulk loading.
+void Atom::insert_atoms(const HandleSeq& hs)
+{
+    if (not (_flags.load() & USE_ISET_FLAG)) return;
+    INCOMING_UNIQUE_LOCK;
+
     InSetMap& iset = get_inset_map();
-    auto bucket = iset.find(at);
-    if (bucket == iset.end())
-    {
-        auto pr = iset.emplace(
-                   std::make_pair(at, WincomingSet()));
-        bucket = pr.first;
-#if USE_SPARSE_INCOMING
-        bucket->second.set_deleted_key(Handle());
-#endif
-    }
-    bucket->second.insert(GET_PTR(a));
+    for (const Handle& a : hs)
+        iset.insert(a->get_type(), GET_PTR(a));
 }
 
 /// Remove an atom from the incoming set.
@@ -489,12 +538,10 @@ void Atom::remove_atom(const Handle& a)
     // extracts.
     if (not have_inset_map()) return;
 
-    InSetMap& iset = get_inset_map();
-    Type at = a->get_type();
-    const auto bucket = iset.find(at);
-
-    OC_ASSERT(bucket != iset.end(), "No bucket!");
-    bucket->second.erase(GET_PTR(a));
+    // The bucket is dropped once it is empty; a Link that holds
+    // the same Atom twice gets removed twice, so the second time
+    // around, there might not be a bucket any more.
+    get_inset_map().erase(a->get_type(), GET_PTR(a));
 
     // Don't bother. Unit test takes this into account.
 #if 0
@@ -533,20 +580,9 @@ void Atom::swap_atom(const Handle& old, const Handle& neu)
     if (not (_flags.load() & USE_ISET_FLAG)) return;
     INCOMING_UNIQUE_LOCK;
 
-    Type ot = old->get_type();
     InSetMap& iset = get_inset_map();
-    auto bucket = iset.find(ot);
-    bucket->second.erase(GET_PTR(old));
-
-    Type nt = neu->get_type();
-    bucket = iset.find(nt);
-    if (bucket == iset.end())
-    {
-        auto pr = iset.emplace(
-                   std::make_pair(nt, WincomingSet()));
-        bucket = pr.first;
-    }
-    bucket->second.insert(GET_PTR(neu));
+    iset.erase(old->get_type(), GET_PTR(old));
+    iset.insert(neu->get_type(), GET_PTR(neu));
 }
 
 // Virtual. Derived classes want to know about incoming set add/remove.
@@ -560,12 +596,10 @@ bool Atom::isIncomingSetEmpty(const AtomSpace* as) const
     if (not have_inset_map()) return false;
 
     const InSetMap& iset = get_inset_map_const();
-    for (const auto& bucket : iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, { if (not as or as->in_environ(l) or nameserver().isA(_type, FRAME)) return false; })
-    }
-    return true;
+    return not iset.any_of([&](Type, const WinkPtr& w) {
+        WEAKLY_DO(l, w, { if (not as or as->in_environ(l) or nameserver().isA(_type, FRAME)) return true; })
+        return false;
+    });
 }
 
 size_t Atom::getIncomingSetSize(const AtomSpace* as) const
@@ -587,21 +621,15 @@ size_t Atom::getIncomingSetSize(const AtomSpace* as) const
         INCOMING_SHARED_LOCK;
         if (not have_inset_map()) return 0;
         const InSetMap& iset = get_inset_map_const();
-        for (const auto& bucket : iset)
-        {
-            for (const WinkPtr& w : bucket.second)
-                WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; })
-        }
+        iset.for_each([&](Type, const WinkPtr& w) {
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; })
+        });
         return cnt;
     }
 
-    size_t cnt = 0;
     INCOMING_SHARED_LOCK;
     if (not have_inset_map()) return 0;
-    const InSetMap& iset = get_inset_map_const();
-    for (const auto& pr : iset)
-        cnt += pr.second.size();
-    return cnt;
+    return get_inset_map_const().size();
 }
 
 /// Add the incoming set for this Atom only to the HandleSet.
@@ -610,29 +638,22 @@ void Atom::getLocalInc(const AtomSpace* as, HandleSet& hs, Type t) const
     INCOMING_SHARED_LOCK;
     if (not have_inset_map()) return;
 
+    auto add_local = [&](const WinkPtr& w) {
+        WEAKLY_DO(l, w, {
+            const Handle& local(as->lookupHandle(l));
+            if (local) hs.insert(local);
+        })
+    };
+
+    const InSetMap& iset = get_inset_map_const();
     if (NOTYPE != t)
     {
-        const InSetMap& iset = get_inset_map_const();
-        const auto bucket = iset.find(t);
-        if (bucket == iset.cend()) return;
-        for (const WinkPtr& w : bucket->second)
-            WEAKLY_DO(l, w, {
-                const Handle& local(as->lookupHandle(l));
-                if (local) hs.insert(local);
-            })
+        iset.for_each(t, add_local);
         return;
     }
 
     // If NOTYPE was given, then loop over all possibilities.
-    const InSetMap& iset = get_inset_map_const();
-    for (const auto& bucket : iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, {
-                const Handle& local(as->lookupHandle(l));
-                if (local) hs.insert(local);
-            })
-    }
+    iset.for_each([&](Type, const WinkPtr& w) { add_local(w); });
 }
 
 /// Find all copies of this atom in deeper AtomSpaces, and add the
@@ -699,11 +720,9 @@ IncomingSet Atom::getIncomingSet(const AtomSpace* as) const
         if (not have_inset_map()) return empty_set;
         IncomingSet retset;
         const InSetMap& iset = get_inset_map_const();
-        for (const auto& bucket : iset)
-        {
-            for (const WinkPtr& w : bucket.second)
-                WEAKLY_DO(l, w, { if (as->in_environ(l)) retset.emplace_back(l); })
-        }
+        iset.for_each([&](Type, const WinkPtr& w) {
+            WEAKLY_DO(l, w, { if (as->in_environ(l)) retset.emplace_back(l); })
+        });
         return retset;
     }
 
@@ -712,11 +731,10 @@ IncomingSet Atom::getIncomingSet(const AtomSpace* as) const
     if (not have_inset_map()) return empty_set;
     IncomingSet retset;
     const InSetMap& iset = get_inset_map_const();
-    for (const auto& bucket : iset)
-    {
-        for (const WinkPtr& w : bucket.second)
-            WEAKLY_DO(l, w, { retset.emplace_back(l); });
-    }
+    retset.reserve(iset.size());
+    iset.for_each([&](Type, const WinkPtr& w) {
+        WEAKLY_DO(l, w, { retset.emplace_back(l); });
+    });
     return retset;
 }
 
@@ -744,26 +762,20 @@ IncomingSet Atom::getIncomingSetByType(Type type, const AtomSpace* as) const
         // Lock to prevent updates of the set of atoms.
         INCOMING_SHARED_LOCK;
         if (not have_inset_map()) return empty_set;
-        const InSetMap& iset = get_inset_map_const();
-        const auto bucket = iset.find(type);
-        if (bucket == iset.cend()) return empty_set;
-
         IncomingSet result;
-        for (const WinkPtr& w : bucket->second)
+        get_inset_map_const().for_each(type, [&](const WinkPtr& w) {
             WEAKLY_DO(l, w, { if (as->in_environ(l)) result.emplace_back(l); })
+        });
         return result;
     }
 
     // Lock to prevent updates of the set of atoms.
     INCOMING_SHARED_LOCK;
     if (not have_inset_map()) return empty_set;
-    const InSetMap& iset = get_inset_map_const();
-    const auto bucket = iset.find(type);
-    if (bucket == iset.cend()) return empty_set;
-
     IncomingSet result;
-    for (const WinkPtr& w : bucket->second)
+    get_inset_map_const().for_each(type, [&](const WinkPtr& w) {
         WEAKLY_DO(l, w, { result.emplace_back(l); })
+    });
     return result;
 }
 
@@ -786,23 +798,17 @@ size_t Atom::getIncomingSetSizeByType(Type type, const AtomSpace* as) const
 
         INCOMING_SHARED_LOCK;
         if (not have_inset_map()) return 0;
-        const InSetMap& iset = get_inset_map_const();
-        const auto bucket = iset.find(type);
-        if (bucket == iset.cend()) return 0;
-
-        for (const WinkPtr& w : bucket->second)
+        get_inset_map_const().for_each(type, [&](const WinkPtr& w) {
             WEAKLY_DO(l, w, { if (as->in_environ(l)) cnt++; })
+        });
         return cnt;
     }
 
     INCOMING_SHARED_LOCK;
     if (not have_inset_map()) return 0;
-    const InSetMap& iset = get_inset_map_const();
-    const auto bucket = iset.find(type);
-    if (bucket == iset.cend()) return 0;
-
-    for (const WinkPtr& w : bucket->second)
+    get_inset_map_const().for_each(type, [&](const WinkPtr& w) {
         WEAKLY_DO(l, w, { cnt++; })
+    });
     return cnt;
 }
 
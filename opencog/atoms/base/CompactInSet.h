@@ -0,0 +1,337 @@
+/*
+ * opencog/atoms/base/CompactInSet.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Small-size-optimized storage for the incoming set of an Atom.
+ */
+
+#ifndef _OPENCOG_COMPACT_IN_SET_H
+#define _OPENCOG_COMPACT_IN_SET_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * The incoming set of an Atom, bucketed by the type of the Links in
+ * it. Almost all Atoms have only a few Links in their incoming set,
+ * usually of just one type. Those are kept in-line, in a small array
+ * of (type, weak-pointer) pairs; there are no tree or hash nodes to
+ * allocate at all. When the in-line array overflows, everything is
+ * moved to a `std::map<Type, Set>`, i.e. one `Set` per type, which
+ * is what is needed for the huge incoming sets that some Atoms have.
+ * The map is dropped again when the last Link is removed.
+ *
+ * The in-line entries are kept sorted by type, and then by owner,
+ * so that iteration order is the same as it is for the map.
+ *
+ * Not thread-safe; the Atom holding this does the locking.
+ */
+template<typename W, typename Set>
+class CompactInSet
+{
+public:
+    static constexpr uint8_t INLINE = 3;
+
+private:
+    typedef std::map<Type, Set> SpillMap;
+    static constexpr uint8_t SPILLED = 0xff;
+
+    union {
+        W _inl[INLINE];
+        SpillMap* _big;
+    };
+    Type _types[INLINE];
+    uint8_t _n;
+
+    static bool less(Type ta, const W& a, Type tb, const W& b)
+    {
+        if (ta != tb) return ta < tb;
+        return std::owner_less<W>()(a, b);
+    }
+
+    static bool same(const W& a, const W& b)
+    {
+        return not std::owner_less<W>()(a, b) and
+               not std::owner_less<W>()(b, a);
+    }
+
+    // google::sparse_hash_set needs a deleted key before use.
+    template<typename S>
+    static auto init_bucket(S& s, int)
+        -> decltype(s.set_deleted_key(typename S::key_type()), void())
+    { s.set_deleted_key(typename S::key_type()); }
+    template<typename S>
+    static void init_bucket(S&, long) {}
+
+    Set& bucket(Type t)
+    {
+        auto it = _big->find(t);
+        if (it != _big->end()) return it->second;
+        Set& s = (*_big)[t];
+        init_bucket(s, 0);
+        return s;
+    }
+
+    // Move the in-line entries to the map.
+    void spill(void)
+    {
+        SpillMap* big = new SpillMap();
+        for (uint8_t i = 0; i < _n; i++)
+        {
+            auto it = big->find(_types[i]);
+            if (it == big->end())
+            {
+                it = big->emplace(_types[i], Set()).first;
+                init_bucket(it->second, 0);
+            }
+            it->second.insert(_inl[i]);
+            _inl[i].~W();
+        }
+        _big = big;
+        _n = SPILLED;
+    }
+
+    // Drop empty buckets; go back to in-line storage when all are gone.
+    void drop_if_empty(typename SpillMap::iterator it)
+    {
+        if (0 < it->second.size()) return;
+        _big->erase(it);
+        if (_big->empty()) destroy();
+    }
+
+    void destroy(void)
+    {
+        if (SPILLED == _n) delete _big;
+        else
+            for (uint8_t i = 0; i < _n; i++) _inl[i].~W();
+        _n = 0;
+    }
+
+public:
+    CompactInSet(void) : _n(0) {}
+    ~CompactInSet() { destroy(); }
+
+    CompactInSet(const CompactInSet& other) : _n(0)
+    {
+        other.for_each([this](Type t, const W& w) { insert(t, w); });
+    }
+
+    CompactInSet(CompactInSet&& other) noexcept : _n(0)
+    {
+        swap(other);
+    }
+
+    CompactInSet& operator=(CompactInSet other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    void swap(CompactInSet& other) noexcept
+    {
+        CompactInSet* a = this;
+        CompactInSet* b = &other;
+        if (SPILLED == a->_n) std::swap(a, b);
+
+        // Now `a` is in-line, unless both are spilled.
+        if (SPILLED == a->_n)
+        {
+            std::swap(a->_big, b->_big);
+            return;
+        }
+
+        // Swap the common prefix, then move the rest over.
+        if (SPILLED == b->_n)
+        {
+            SpillMap* big = b->_big;
+            for (uint8_t i = 0; i < a->_n; i++)
+            {
+                new (&b->_inl[i]) W(std::move(a->_inl[i]));
+                b->_types[i] = a->_types[i];
+                a->_inl[i].~W();
+            }
+            b->_n = a->_n;
+            a->_big = big;
+            a->_n = SPILLED;
+            return;
+        }
+
+        if (a->_n < b->_n) std::swap(a, b);
+        uint8_t i = 0;
+        for (; i < b->_n; i++)
+        {
+            std::swap(a->_inl[i], b->_inl[i]);
+            std::swap(a->_types[i], b->_types[i]);
+        }
+        for (; i < a->_n; i++)
+        {
+            new (&b->_inl[i]) W(std::move(a->_inl[i]));
+            b->_types[i] = a->_types[i];
+            a->_inl[i].~W();
+        }
+        std::swap(a->_n, b->_n);
+    }
+
+    /// Add `w`, a Link of type `t`. Adding it twice is harmless.
+    void insert(Type t, const W& w)
+    {
+        if (SPILLED == _n)
+        {
+            bucket(t).insert(w);
+            return;
+        }
+
+        uint8_t pos = 0;
+        while (pos < _n and less(_types[pos], _inl[pos], t, w)) pos++;
+        if (pos < _n and _types[pos] == t and same(_inl[pos], w)) return;
+
+        if (INLINE == _n)
+        {
+            spill();
+            bucket(t).insert(w);
+            return;
+        }
+
+        new (&_inl[_n]) W(w);
+        _types[_n] = t;
+        for (uint8_t i = _n; i > pos; i--)
+        {
+            std::swap(_inl[i], _inl[i-1]);
+            std::swap(_types[i], _types[i-1]);
+        }
+        _n++;
+    }
+
+    /// Remove `w`, a Link of type `t`, if present.
+    void erase(Type t, const W& w)
+    {
+        if (SPILLED != _n)
+        {
+            erase_if(t, [&w](const W& x) { return same(x, w); });
+            return;
+        }
+        auto it = _big->find(t);
+        if (it == _big->end()) return;
+        it->second.erase(w);
+        drop_if_empty(it);
+    }
+
+    /// Remove all Links of type `t` for which `pred` holds.
+    template<typename P>
+    void erase_if(Type t, P pred)
+    {
+        if (SPILLED == _n)
+        {
+            auto it = _big->find(t);
+            if (it == _big->end()) return;
+            Set& s = it->second;
+            for (auto bi = s.begin(); bi != s.end(); )
+            {
+                if (pred(*bi))
+                {
+                    auto dead = bi++;
+                    s.erase(dead);
+                }
+                else bi++;
+            }
+            drop_if_empty(it);
+            return;
+        }
+
+        uint8_t j = 0;
+        for (uint8_t i = 0; i < _n; i++)
+        {
+            if (_types[i] == t and pred(_inl[i])) continue;
+            if (i != j)
+            {
+                std::swap(_inl[i], _inl[j]);
+                std::swap(_types[i], _types[j]);
+            }
+            j++;
+        }
+        for (uint8_t i = j; i < _n; i++) _inl[i].~W();
+        _n = j;
+    }
+
+    /// Call `f(type, w)` on each Link, until `f` returns true.
+    /// Return true if it did.
+    template<typename F>
+    bool any_of(F f) const
+    {
+        if (SPILLED != _n)
+        {
+            for (uint8_t i = 0; i < _n; i++)
+                if (f(_types[i], _inl[i])) return true;
+            return false;
+        }
+        for (const auto& pr : *_big)
+            for (const W& w : pr.second)
+                if (f(pr.first, w)) return true;
+        return false;
+    }
+
+    /// Call `f(type, w)` on each Link.
+    template<typename F>
+    void for_each(F f) const
+    {
+        any_of([&f](Type t, const W& w) { f(t, w); return false; });
+    }
+
+    /// Call `f(w)` on each Link of type `t`.
+    template<typename F>
+    void for_each(Type t, F f) const
+    {
+        if (SPILLED != _n)
+        {
+            for (uint8_t i = 0; i < _n; i++)
+                if (_types[i] == t) f(_inl[i]);
+            return;
+        }
+        auto it = _big->find(t);
+        if (it == _big->end()) return;
+        for (const W& w : it->second) f(w);
+    }
+
+    size_t size(void) const
+    {
+        if (SPILLED != _n) return _n;
+        size_t cnt = 0;
+        for (const auto& pr : *_big) cnt += pr.second.size();
+        return cnt;
+    }
+
+    size_t size(Type t) const
+    {
+        if (SPILLED != _n)
+        {
+            size_t cnt = 0;
+            for (uint8_t i = 0; i < _n; i++)
+                if (_types[i] == t) cnt++;
+            return cnt;
+        }
+        auto it = _big->find(t);
+        if (it == _big->end()) return 0;
+        return it->second.size();
+    }
+
+    bool empty(void) const { return 0 == _n; }
+    void clear(void) { destroy(); }
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_COMPACT_IN_SET_H
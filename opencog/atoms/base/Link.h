@@ -188,7 +188,7 @@ LINK_PTR_DECL(Link);
 template< class... Args >
 Handle createLink( Args&&... args )
 {
-	Handle tmp(std::make_shared<Link>(std::forward<Args>(args) ...));
+	Handle tmp(make_atom<Link>(std::forward<Args>(args) ...));
 	return classserver().factory(tmp);
 }
 
@@ -118,7 +118,7 @@ NODE_PTR_DECL(Node)
 template< class... Args >
 Handle createNode( Args&&... args )
 {
-   Handle tmp(std::make_shared<Node>(std::forward<Args>(args) ...));
+   Handle tmp(make_atom<Node>(std::forward<Args>(args) ...));
    return classserver().factory(tmp);
 }
 
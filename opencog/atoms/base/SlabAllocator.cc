@@ -0,0 +1,126 @@
+/*
+ * opencog/atoms/base/SlabAllocator.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Size-class slab allocation for Atoms, with per-thread free lists.
+ */
+
+#include <mutex>
+
+#include "SlabAllocator.h"
+
+using namespace opencog;
+
+thread_local SlabPool::Cache SlabPool::_cache;
+
+// Chains of free blocks, shared by all threads.
+struct SlabPool::Depot
+{
+    std::mutex mtx;
+    Block* head[NCLASSES] = {};
+
+    // Splice the chain `first ... last` onto the front.
+    void put(size_t cls, Block* first, Block* last)
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        last->next = head[cls];
+        head[cls] = first;
+    }
+
+    // Take up to `n` blocks; return how many were taken.
+    size_t take(size_t cls, size_t n, Block*& first)
+    {
+        std::lock_guard<std::mutex> lck(mtx);
+        first = head[cls];
+        if (nullptr == first) return 0;
+        size_t cnt = 1;
+        Block* last = first;
+        while (cnt < n and last->next) { last = last->next; cnt++; }
+        head[cls] = last->next;
+        last->next = nullptr;
+        return cnt;
+    }
+
+    // Never destroyed: Atoms held in static variables are freed
+    // during exit, after a static Depot would have been destroyed.
+    static Depot& get(void)
+    {
+        static Depot* dep = new Depot();
+        return *dep;
+    }
+};
+
+// Gives the free lists of an exiting thread to the depot.
+struct SlabPool::Guard
+{
+    bool armed = false;
+    ~Guard()
+    {
+        for (size_t cls = 0; cls < NCLASSES; cls++)
+        {
+            Block* first = _cache.head[cls];
+            if (nullptr == first) continue;
+            Block* last = first;
+            while (last->next) last = last->next;
+            Depot::get().put(cls, first, last);
+            _cache.head[cls] = nullptr;
+            _cache.count[cls] = 0;
+        }
+        _cache.gone = true;
+    }
+};
+
+thread_local SlabPool::Guard SlabPool::_guard;
+
+// The thread's free list is empty: take a batch from the depot,
+// or else cut a new slab into blocks.
+void* SlabPool::refill(size_t cls)
+{
+    Block* first;
+    if (_cache.gone)
+    {
+        if (0 < Depot::get().take(cls, 1, first)) return first;
+        return ::operator new(block_size(cls));
+    }
+
+    // Make sure the blocks come back when this thread exits.
+    _guard.armed = true;
+
+    size_t got = Depot::get().take(cls, BATCH, first);
+    if (0 == got)
+    {
+        size_t bsz = block_size(cls);
+        got = SLAB_BYTES / bsz;
+        char* slab = static_cast<char*>(::operator new(SLAB_BYTES));
+        for (size_t i = 0; i < got - 1; i++)
+            reinterpret_cast<Block*>(slab + i * bsz)->next =
+                reinterpret_cast<Block*>(slab + (i+1) * bsz);
+        reinterpret_cast<Block*>(slab + (got-1) * bsz)->next = nullptr;
+        first = reinterpret_cast<Block*>(slab);
+    }
+
+    _cache.head[cls] = first->next;
+    _cache.count[cls] = got - 1;
+    return first;
+}
+
+// Hand a batch of blocks back to the depot.
+void SlabPool::flush(size_t cls)
+{
+    Block* first = _cache.head[cls];
+    Block* last = first;
+    for (size_t i = 1; i < BATCH; i++) last = last->next;
+    _cache.head[cls] = last->next;
+    _cache.count[cls] -= BATCH;
+    Depot::get().put(cls, first, last);
+}
+
+// Return a chain of blocks straight to the depot.
+void SlabPool::release(size_t cls, Block* first) noexcept
+{
+    Block* last = first;
+    while (last->next) last = last->next;
+    Depot::get().put(cls, first, last);
+}
@@ -0,0 +1,165 @@
+/*
+ * opencog/atoms/base/SlabAllocator.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Size-class slab allocation for Atoms, with per-thread free lists.
+ */
+
+#ifndef _OPENCOG_SLAB_ALLOCATOR_H
+#define _OPENCOG_SLAB_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+// Allocate Atoms out of size-class slabs, instead of calling malloc
+// for each one. Atoms are small (a few hundred bytes, together with
+// the shared_ptr control block), and many of them are short-lived:
+// the pattern matcher, PutLink beta reduction and RewriteLink all
+// create and then discard Atoms at a high rate. Each thread keeps
+// its own free lists, so that alloc and free take no locks in the
+// common case. See the `transient_bm` benchmark in `tests/benchmark`.
+//
+// Memory that has been carved into slabs is recycled, but is never
+// given back to the operating system. Comment this out to go back to
+// plain `std::make_shared`.
+#define USE_SLAB_ALLOC 1
+
+/**
+ * Fixed-size blocks, in multiples of ALIGN bytes, up to MAX_SIZE.
+ * Freed blocks go onto the free list of the freeing thread. Threads
+ * that free more than they allocate hand batches of blocks to a
+ * shared depot, where other threads pick them up. The free lists of
+ * exiting threads go to the depot, too.
+ */
+class SlabPool
+{
+public:
+    static constexpr size_t ALIGN = 16;
+    static constexpr size_t MAX_SIZE = 512;
+    static constexpr size_t NCLASSES = MAX_SIZE / ALIGN;
+
+    static bool fits(size_t sz, size_t align)
+    { return sz <= MAX_SIZE and align <= ALIGN; }
+
+    static void* allocate(size_t sz)
+    {
+        size_t cls = size_class(sz);
+        Block* blk = _cache.head[cls];
+        if (nullptr == blk) return refill(cls);
+        _cache.head[cls] = blk->next;
+        _cache.count[cls]--;
+        return blk;
+    }
+
+    static void deallocate(void* p, size_t sz) noexcept
+    {
+        size_t cls = size_class(sz);
+        Block* blk = static_cast<Block*>(p);
+        if (_cache.gone) { blk->next = nullptr; release(cls, blk); return; }
+        blk->next = _cache.head[cls];
+        _cache.head[cls] = blk;
+        if (high_water(cls) < ++_cache.count[cls]) flush(cls);
+    }
+
+private:
+    static constexpr size_t SLAB_BYTES = 64 * 1024;
+
+    // Number of blocks moved between a thread and the depot at a time.
+    static constexpr size_t BATCH = 64;
+
+    struct Block { Block* next; };
+
+    // The free lists of one thread. Trivial, so that getting at it
+    // is just a TLS lookup. Atoms can be freed after the thread has
+    // given its blocks back, e.g. when static variables are destroyed;
+    // `gone` is set then.
+    struct Cache
+    {
+        Block* head[NCLASSES];
+        size_t count[NCLASSES];
+        bool gone;
+    };
+    static thread_local Cache _cache;
+
+    static size_t size_class(size_t sz)
+    { return (0 == sz) ? 0 : (sz - 1) / ALIGN; }
+
+    static size_t block_size(size_t cls)
+    { return (cls + 1) * ALIGN; }
+
+    // A thread holding more free blocks than this gives some back.
+    static size_t high_water(size_t cls)
+    { return SLAB_BYTES / block_size(cls) + BATCH; }
+
+    struct Depot;
+    struct Guard;
+    static thread_local Guard _guard;
+    static void* refill(size_t);
+    static void flush(size_t);
+    static void release(size_t, Block*) noexcept;
+};
+
+/**
+ * A standard allocator, so that it can be passed to
+ * `std::allocate_shared`, which will rebind it to the type of the
+ * combined control block and object. Anything that does not fit
+ * into a size class goes to `operator new`.
+ */
+template<typename T>
+class SlabAllocator
+{
+public:
+    typedef T value_type;
+
+    SlabAllocator(void) noexcept {}
+    template<typename U>
+    SlabAllocator(const SlabAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        if (1 == n and SlabPool::fits(sizeof(T), alignof(T)))
+            return static_cast<T*>(SlabPool::allocate(sizeof(T)));
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        if (1 == n and SlabPool::fits(sizeof(T), alignof(T)))
+            SlabPool::deallocate(p, sizeof(T));
+        else
+            std::allocator<T>().deallocate(p, n);
+    }
+
+    template<typename U>
+    bool operator==(const SlabAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const SlabAllocator<U>&) const noexcept { return false; }
+};
+
+/// Create a new Atom of C++ class T; use this instead of
+/// `std::make_shared`.
+template<typename T, typename... Args>
+std::shared_ptr<T> make_atom(Args&&... args)
+{
+#if USE_SLAB_ALLOC
+    return std::allocate_shared<T>(SlabAllocator<T>(),
+                                   std::forward<Args>(args)...);
+#else
+    return std::make_shared<T>(std::forward<Args>(args)...);
+#endif
+}
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_SLAB_ALLOCATOR_H
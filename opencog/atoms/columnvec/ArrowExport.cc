@@ -0,0 +1,276 @@
+/*
+ * opencog/atoms/columnvec/ArrowExport.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <climits>
+#include <cstring>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/StringValue.h>
+
+#include "ArrowExport.h"
+#include "LinkColumn.h"
+#include "SexprColumn.h"
+
+using namespace opencog;
+
+// Arrow wants non-null buffer pointers, even for empty buffers.
+alignas(64) static const int64_t empty_buffer[1] = {0};
+
+// ---------------------------------------------------------------
+// Ownership. The private_data of each struct holds everything that
+// the buffers point into; the release callbacks delete it.
+
+namespace {
+
+struct ArrayData
+{
+	std::vector<const void*> buffers;
+	std::vector<ArrowArray> child_store;
+	std::vector<ArrowArray*> children;
+
+	// Whatever the buffers point into.
+	ValuePtr hold;
+	std::vector<double> doubles;
+	std::vector<int32_t> offsets32;
+	std::vector<int64_t> offsets64;
+	std::string chars;
+};
+
+struct SchemaData
+{
+	std::string format;
+	std::string name;
+	std::vector<ArrowSchema> child_store;
+	std::vector<ArrowSchema*> children;
+};
+
+}
+
+static void release_array(ArrowArray* arr)
+{
+	ArrayData* ad = (ArrayData*) arr->private_data;
+	for (ArrowArray& c : ad->child_store)
+		if (c.release) c.release(&c);
+	delete ad;
+	arr->release = nullptr;
+}
+
+static void release_schema(ArrowSchema* sch)
+{
+	SchemaData* sd = (SchemaData*) sch->private_data;
+	for (ArrowSchema& c : sd->child_store)
+		if (c.release) c.release(&c);
+	delete sd;
+	sch->release = nullptr;
+}
+
+/// Fill in `arr`, taking ownership of `ad`. The buffer pointers must
+/// already be in `ad->buffers`, and the children in `ad->child_store`.
+static void fill_array(ArrowArray* arr, int64_t length, ArrayData* ad)
+{
+	for (ArrowArray& c : ad->child_store)
+		ad->children.push_back(&c);
+
+	arr->length = length;
+	arr->null_count = 0;
+	arr->offset = 0;
+	arr->n_buffers = ad->buffers.size();
+	arr->n_children = ad->children.size();
+	arr->buffers = ad->buffers.data();
+	arr->children = ad->children.empty() ? nullptr : ad->children.data();
+	arr->dictionary = nullptr;
+	arr->release = release_array;
+	arr->private_data = ad;
+}
+
+static void fill_schema(ArrowSchema* sch, const char* format,
+                        const std::string& name, SchemaData* sd)
+{
+	sd->format = format;
+	sd->name = name;
+	for (ArrowSchema& c : sd->child_store)
+		sd->children.push_back(&c);
+
+	sch->format = sd->format.c_str();
+	sch->name = sd->name.c_str();
+	sch->metadata = nullptr;
+	sch->flags = 0;
+	sch->n_children = sd->children.size();
+	sch->children = sd->children.empty() ? nullptr : sd->children.data();
+	sch->dictionary = nullptr;
+	sch->release = release_schema;
+	sch->private_data = sd;
+}
+
+// ---------------------------------------------------------------
+
+void ArrowStrings::export_to(ArrowArray* arr, ArrowSchema* sch,
+                             const std::string& name)
+{
+	ArrayData* ad = new ArrayData();
+	size_t len = size();
+	const char* format = "u";
+	ad->buffers.push_back(nullptr); // No nulls, so no validity bitmap.
+	if (_data.size() <= INT32_MAX)
+	{
+		ad->offsets32.assign(_offsets.begin(), _offsets.end());
+		ad->buffers.push_back(ad->offsets32.data());
+	}
+	else
+	{
+		format = "U";
+		ad->offsets64.swap(_offsets);
+		ad->buffers.push_back(ad->offsets64.data());
+	}
+	ad->chars.swap(_data);
+	ad->buffers.push_back(ad->chars.data());
+
+	_offsets.assign({0});
+	_data.clear();
+
+	fill_array(arr, len, ad);
+	fill_schema(sch, format, name, new SchemaData());
+}
+
+// ---------------------------------------------------------------
+
+void opencog::arrow_export_struct(std::vector<ArrowArray>& cols,
+                                  std::vector<ArrowSchema>& schs,
+                                  ArrowArray* arr, ArrowSchema* sch,
+                                  const std::string& name)
+{
+	int64_t len = cols.empty() ? 0 : cols[0].length;
+	for (const ArrowArray& c : cols)
+	{
+		if (c.length == len) continue;
+		for (ArrowArray& a : cols) if (a.release) a.release(&a);
+		for (ArrowSchema& s : schs) if (s.release) s.release(&s);
+		throw RuntimeException(TRACE_INFO,
+			"Columns must all have the same length; got %ld and %ld",
+			len, c.length);
+	}
+
+	// Moving the structs is allowed by the C Data Interface, as long
+	// as the originals are marked as released.
+	ArrayData* ad = new ArrayData();
+	ad->buffers.push_back(nullptr);
+	ad->child_store = cols;
+	for (ArrowArray& c : cols) c.release = nullptr;
+	cols.clear();
+	fill_array(arr, len, ad);
+
+	SchemaData* sd = new SchemaData();
+	sd->child_store = schs;
+	for (ArrowSchema& s : schs) s.release = nullptr;
+	schs.clear();
+	fill_schema(sch, "+s", name, sd);
+}
+
+// ---------------------------------------------------------------
+
+static void export_floats(const ValuePtr& vp, ArrowArray* arr,
+                          ArrowSchema* sch, const std::string& name)
+{
+	ArrayData* ad = new ArrayData();
+	const double* data;
+	size_t len;
+
+	// Plain FloatValues never change, and so can be handed out as-is.
+	// Streams (RandomStream, FormulaStream, ...) update themselves, so
+	// a snapshot is needed.
+	if (FLOAT_VALUE == vp->get_type())
+	{
+		ad->hold = vp;
+		const std::vector<double>& dv = FloatValueCast(vp)->value();
+		data = dv.data();
+		len = dv.size();
+	}
+	else
+	{
+		ad->doubles = FloatValueCast(vp)->value();
+		data = ad->doubles.data();
+		len = ad->doubles.size();
+	}
+
+	ad->buffers.push_back(nullptr);
+	ad->buffers.push_back(0 < len ? (const void*) data : empty_buffer);
+	fill_array(arr, len, ad);
+	fill_schema(sch, "g", name, new SchemaData());
+}
+
+void opencog::arrow_export(const ValuePtr& vp, ArrowArray* arr,
+                           ArrowSchema* sch, const std::string& name)
+{
+	if (vp->is_type(FLOAT_VALUE))
+	{
+		export_floats(vp, arr, sch, name);
+		return;
+	}
+
+	if (vp->is_type(STRING_VALUE))
+	{
+		const std::vector<std::string>& sv = StringValueCast(vp)->value();
+		ArrowStrings strs;
+		strs.reserve(sv.size());
+		for (const std::string& s : sv)
+			strs.append(s);
+		strs.export_to(arr, sch, name);
+		return;
+	}
+
+	if (vp->is_type(LINK_VALUE))
+	{
+		const ValueSeq& vseq = LinkValueCast(vp)->value();
+		std::vector<ArrowArray> cols(vseq.size());
+		std::vector<ArrowSchema> schs(vseq.size());
+		try
+		{
+			for (size_t i = 0; i < vseq.size(); i++)
+				arrow_export(vseq[i], &cols[i], &schs[i], std::to_string(i));
+		}
+		catch (...)
+		{
+			for (ArrowArray& a : cols) if (a.release) a.release(&a);
+			for (ArrowSchema& s : schs) if (s.release) s.release(&s);
+			throw;
+		}
+		arrow_export_struct(cols, schs, arr, sch, name);
+		return;
+	}
+
+	throw RuntimeException(TRACE_INFO,
+		"Cannot export to Arrow: %s", vp->to_short_string().c_str());
+}
+
+void opencog::arrow_export(AtomSpace* as, const Handle& h,
+                           ArrowArray* arr, ArrowSchema* sch,
+                           bool silent, const std::string& name)
+{
+	Type t = h->get_type();
+	if (nameserver().isA(t, SEXPR_COLUMN))
+	{
+		SexprColumnCast(h)->export_arrow(as, silent, arr, sch, name);
+		return;
+	}
+	if (nameserver().isA(t, LINK_COLUMN))
+	{
+		LinkColumnCast(h)->export_arrow(as, silent, arr, sch, name);
+		return;
+	}
+
+	if (not h->is_executable())
+		throw RuntimeException(TRACE_INFO,
+			"Expecting a column or other executable Atom, got %s",
+			h->to_short_string().c_str());
+
+	// FloatColumns produce a single FloatValue; it is exported
+	// without copying.
+	arrow_export(h->execute(as, silent), arr, sch, name);
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,132 @@
+/*
+ * opencog/atoms/columnvec/ArrowExport.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Export of column data through the Apache Arrow C Data Interface.
+ */
+
+#ifndef _OPENCOG_ARROW_EXPORT_H
+#define _OPENCOG_ARROW_EXPORT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+// The Arrow C Data Interface. These two structs are a stable ABI,
+// defined in the Arrow specification; they are copied here so that
+// there is no dependency on libarrow. The guard is the one given by
+// the specification, so that this can be included alongside the
+// Arrow headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+	// Array type description
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowSchema*);
+	// Opaque producer-specific data
+	void* private_data;
+};
+
+struct ArrowArray {
+	// Array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+
+	// Release callback
+	void (*release)(struct ArrowArray*);
+	// Opaque producer-specific data
+	void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace opencog
+{
+class AtomSpace;
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/// Collects strings into the Arrow layout for utf8 columns: one
+/// offsets array, and one contiguous block holding all of the
+/// characters. This avoids building a vector of std::string first.
+class ArrowStrings
+{
+	std::vector<int64_t> _offsets;
+	std::string _data;
+
+public:
+	ArrowStrings(void) : _offsets({0}) {}
+
+	void reserve(size_t n) { _offsets.reserve(n+1); }
+	void append(const std::string& s)
+	{
+		_data.append(s);
+		_offsets.push_back(_data.size());
+	}
+	size_t size(void) const { return _offsets.size() - 1; }
+
+	/// Hand the strings over to Arrow, leaving this empty. The format
+	/// is "u" (32-bit offsets) unless the data is too large for that,
+	/// in which case it is "U".
+	void export_to(ArrowArray*, ArrowSchema*, const std::string& = "");
+};
+
+/// Export a Value to Arrow. FloatValues become float64 columns, and
+/// their data is not copied; the FloatValue is held until the array
+/// is released. StringValues become utf8 columns. A LinkValue holding
+/// columns of equal length becomes a struct (i.e. a table), with one
+/// child per column. Anything else throws.
+///
+/// The caller owns the returned structs, and must call their
+/// `release` callbacks when done with them.
+void arrow_export(const ValuePtr&, ArrowArray*, ArrowSchema*,
+                  const std::string& name = "");
+
+/// Export the result of executing a column Atom (SexprColumn,
+/// FloatColumn, LinkColumn) or any other executable Atom. The column
+/// Atoms write the Arrow buffers directly, without building an
+/// intermediate Value.
+void arrow_export(AtomSpace*, const Handle&, ArrowArray*, ArrowSchema*,
+                  bool silent = false, const std::string& name = "");
+
+/// Combine columns of equal length into a struct (a table). The
+/// columns are moved into the struct, which takes over releasing them.
+void arrow_export_struct(std::vector<ArrowArray>&,
+                         std::vector<ArrowSchema>&,
+                         ArrowArray*, ArrowSchema*,
+                         const std::string& name = "");
+
+/** @}*/
+}
+
+#endif // _OPENCOG_ARROW_EXPORT_H
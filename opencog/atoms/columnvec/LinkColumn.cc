@@ -85,6 +85,45 @@ ValuePtr LinkColumn::do_execute(AtomSpace* as, bool silent)
 
 // ---------------------------------------------------------------
 
+/// Fill in an Arrow struct, one child per column.
+void LinkColumn::export_arrow(AtomSpace* as, bool silent,
+                              ArrowArray* arr, ArrowSchema* sch,
+                              const std::string& name)
+{
+	const HandleSeq* hseq = &_outgoing;
+	if (1 == _outgoing.size() and
+	    not _outgoing[0]->is_type(COLUMN))
+	{
+		// Something that computes the whole table, e.g. a query.
+		if (_outgoing[0]->is_executable())
+		{
+			arrow_export(do_execute(as, silent), arr, sch, name);
+			return;
+		}
+		hseq = &_outgoing[0]->getOutgoingSet();
+	}
+
+	// The columns export themselves; that way, SexprColumns write
+	// straight into Arrow, without making a StringValue first.
+	std::vector<ArrowArray> cols(hseq->size());
+	std::vector<ArrowSchema> schs(hseq->size());
+	try
+	{
+		for (size_t i = 0; i < hseq->size(); i++)
+			arrow_export(as, (*hseq)[i], &cols[i], &schs[i],
+			             silent, std::to_string(i));
+	}
+	catch (...)
+	{
+		for (ArrowArray& a : cols) if (a.release) a.release(&a);
+		for (ArrowSchema& s : schs) if (s.release) s.release(&s);
+		throw;
+	}
+	arrow_export_struct(cols, schs, arr, sch, name);
+}
+
+// ---------------------------------------------------------------
+
 /// Return a FloatValue vector.
 ValuePtr LinkColumn::execute(AtomSpace* as, bool silent)
 {
@@ -24,6 +24,7 @@
 #define _OPENCOG_LINK_COLUMN_H
 
 #include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/columnvec/ArrowExport.h>
 
 namespace opencog
 {
@@ -62,6 +63,11 @@ public:
 	// Return a pointer to LinkValue holding a list of Values.
 	virtual ValuePtr execute(AtomSpace*, bool);
 
+	// Export as an Arrow struct (a table), with one child for each
+	// of the wrapped columns.
+	void export_arrow(AtomSpace*, bool, ArrowArray*, ArrowSchema*,
+	                  const std::string& name = "");
+
 	static Handle factory(const Handle&);
 };
 
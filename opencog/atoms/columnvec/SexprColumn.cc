@@ -47,8 +47,10 @@ SexprColumn::SexprColumn(const HandleSeq&& oset, Type t)
 
 // ---------------------------------------------------------------
 
-/// Return a StringValue vector.
-ValuePtr SexprColumn::do_execute(AtomSpace* as, bool silent)
+/// Pass the s-expressions to the sink, one at a time. The sink is
+/// either a vector of strings, or the Arrow string builder.
+template<typename SINK>
+void SexprColumn::collect(AtomSpace* as, bool silent, SINK& sink)
 {
 	// If the given Atom is executable, then execute it.
 	Handle base(_outgoing[0]);
@@ -60,28 +62,59 @@ ValuePtr SexprColumn::do_execute(AtomSpace* as, bool silent)
 		else
 		{
 			if (not vp->is_type(LINK_VALUE))
-				return createStringValue(vp->to_string());
+			{
+				sink.append(vp->to_string());
+				return;
+			}
 
 			// If we are here, we've got a LinkValue
-			std::vector<std::string> svec;
-			svec.reserve(vp->size());
+			sink.reserve(vp->size());
 			for (const ValuePtr& v : LinkValueCast(vp)->value())
-				svec.push_back(v->to_short_string());
-			return createStringValue(std::move(svec));
+				sink.append(v->to_short_string());
+			return;
 		}
 	}
 
 	// If we are here, then base is an atom.
 	if (base->is_node())
-		return createStringValue(base->to_short_string());
+	{
+		sink.append(base->to_short_string());
+		return;
+	}
 
 	// If we are here, then base is an link.
-	std::vector<std::string> svec;
-	svec.reserve(base->get_arity());
+	sink.reserve(base->get_arity());
 	for (const Handle& h : base->getOutgoingSet())
-		svec.push_back(h->to_short_string());
+		sink.append(h->to_short_string());
+}
+
+namespace {
+struct StringSink
+{
+	std::vector<std::string> svec;
+	void reserve(size_t n) { svec.reserve(n); }
+	void append(std::string&& s) { svec.push_back(std::move(s)); }
+};
+}
 
-	return createStringValue(std::move(svec));
+/// Return a StringValue vector.
+ValuePtr SexprColumn::do_execute(AtomSpace* as, bool silent)
+{
+	StringSink sink;
+	collect(as, silent, sink);
+	return createStringValue(std::move(sink.svec));
+}
+
+// ---------------------------------------------------------------
+
+/// Fill in an Arrow utf8 column.
+void SexprColumn::export_arrow(AtomSpace* as, bool silent,
+                               ArrowArray* arr, ArrowSchema* sch,
+                               const std::string& name)
+{
+	ArrowStrings strs;
+	collect(as, silent, strs);
+	strs.export_to(arr, sch, name);
 }
 
 // ---------------------------------------------------------------
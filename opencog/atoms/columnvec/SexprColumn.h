@@ -24,6 +24,7 @@
 #define _OPENCOG_SEXPR_COLUMN_H
 
 #include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/columnvec/ArrowExport.h>
 
 namespace opencog
 {
@@ -48,6 +49,7 @@ namespace opencog
 class SexprColumn : public Link
 {
 protected:
+	template<typename SINK> void collect(AtomSpace*, bool, SINK&);
 	ValuePtr do_execute(AtomSpace*, bool);
 
 public:
@@ -60,6 +62,10 @@ public:
 	// Return a pointer to StringValue holding the s-expressions
 	virtual ValuePtr execute(AtomSpace*, bool);
 
+	// Write the s-expressions straight into an Arrow utf8 column.
+	void export_arrow(AtomSpace*, bool, ArrowArray*, ArrowSchema*,
+	                  const std::string& name = "");
+
 	static Handle factory(const Handle&);
 };
 
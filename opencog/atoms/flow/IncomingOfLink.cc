@@ -21,8 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/signature/TypeNode.h>
 #include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atomspace/AtomSpace.h>
 
 #include "IncomingOfLink.h"
 
@@ -40,9 +42,9 @@ IncomingOfLink::IncomingOfLink(const HandleSeq&& oset, Type t)
 
 	size_t sz = _outgoing.size();
 
-	if (1 != sz and 2 != sz)
+	if (1 > sz or 3 < sz)
 		throw InvalidParamException(TRACE_INFO,
-			"IncomingOfLink expects one or two args, got %lu", sz);
+			"IncomingOfLink expects one to three args, got %lu", sz);
 }
 
 // ---------------------------------------------------------------
@@ -74,7 +76,42 @@ ValuePtr IncomingOfLink::execute(AtomSpace* as, bool silent)
 
 	TypeNodePtr tnp = TypeNodeCast(tnode);
 	Type intype = tnp->get_kind();
-	HandleSeq iset(base->getIncomingSetByType(intype));
+	if (2 == _outgoing.size())
+	{
+		HandleSeq iset(base->getIncomingSetByType(intype));
+		return createLinkValue(std::move(iset));
+	}
+
+	// Get incoming set by type and position.
+	Handle pnode(_outgoing[2]);
+	if (pnode->is_executable())
+		pnode = HandleCast(pnode->execute(as, silent));
+
+	if (nullptr == pnode or not pnode->is_type(NUMBER_NODE))
+		throw RuntimeException(TRACE_INFO,
+			"IncomingOfLink expects a position; got %s",
+			pnode ? pnode->to_string().c_str() : "null");
+
+	const std::vector<double>& pa(NumberNodeCast(pnode)->value());
+	if (pa.empty() or pa[0] < 0.0 or (1 < pa.size() and pa[1] < 0.0))
+		throw RuntimeException(TRACE_INFO,
+			"IncomingOfLink expects a non-negative position; got %s",
+			pnode->to_string().c_str());
+
+	Arity pos = pa[0];
+	Arity arity = (1 < pa.size()) ? pa[1] : 0;
+
+	HandleSeq iset;
+	if (as and as->get_incoming_by_position(iset, base, intype, pos, arity))
+		return createLinkValue(std::move(iset));
+
+	// No index; look at all of them.
+	for (const Handle& h : base->getIncomingSetByType(intype, as))
+	{
+		if (0 != arity and h->size() != arity) continue;
+		if (h->size() <= pos or h->getOutgoingAtom(pos) != base) continue;
+		iset.emplace_back(h);
+	}
 	return createLinkValue(std::move(iset));
 }
 
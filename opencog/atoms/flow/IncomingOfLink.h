@@ -44,6 +44,20 @@ namespace opencog
 ///
 ///     (LinkValue (Evaluation (Predicate "foo") ...) ...)
 ///
+/// A third argument, a NumberNode, restricts the result to those Links
+/// holding the Atom at the given position. A second number in it
+/// restricts the arity. So
+///
+///     IncomingOfLink
+///         Predicate "foo"
+///         TypeNode 'EvaluationLink
+///         NumberNode "0 2"
+///
+/// returns only the EvaluationLinks of arity two, with the predicate
+/// in front. This is fast, even when "foo" has a huge incoming set,
+/// if the AtomSpace indexes EvaluationLinks by position. See
+/// `AtomSpace::index_positions()`.
+///
 class IncomingOfLink : public FunctionLink
 {
 public:
@@ -22,16 +22,12 @@
  */
 
 #include <cmath>
-#include <thread>
-
-#include <opencog/util/platform.h>
-#include <opencog/util/concurrent_queue.h>
 
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/parallel/ExecuteThreadedLink.h>
+#include <opencog/atoms/parallel/TaskPool.h>
 #include <opencog/atoms/value/QueueValue.h>
 #include <opencog/atomspace/AtomSpace.h>
-#include <opencog/eval/FrameStack.h>
 
 using namespace opencog;
 
@@ -59,6 +55,12 @@ using namespace opencog;
 /// By default, the number of threads launched equals the number of
 /// Atoms in the set. If the NumberNode is present, then the number of
 /// threads is the smaller of the NumberNode and the size of the Set.
+/// The threads are taken from the shared TaskPool, and so the number
+/// actually running at once is also limited by the size of the pool.
+///
+/// If an execution throws, no further Atoms are started, and the
+/// exception is passed on to the reader of the QueueValue, after the
+/// results that were obtained before it.
 ///
 /// XXX TODO: If nthreads = 0, just execute directly here, in the
 /// current thread, and block till execution is done.
@@ -96,62 +98,82 @@ ExecuteThreadedLink::ExecuteThreadedLink(const HandleSeq&& oset, Type t)
 	_nthreads = std::min(_nthreads, nitems);
 }
 
-ExecuteThreadedLink::~ExecuteThreadedLink()
-{
-	// Must make sure the memory for the thread status outlives
-	// the thread it's tracking; otherwise we risk freeing the
-	// RAM for _joiner, after which the joiner thread will write
-	// to it. As long as this Atom is in an AtomSpace, this dtor
-	// will never run, but if the AtomSpace is being destroyed,
-	// then bad things happen without this. e.g. ThreadedUTest.
-	if (_joiner.joinable())
-		_joiner.join();
-}
+namespace {
 
-static void thread_exec(AtomSpace* as, bool silent,
-                        concurrent_queue<Handle>* todo,
-                        QueueValuePtr qvp,
-                        std::exception_ptr* returned_ex)
+// State shared by all of the tasks of one execution.
+struct ExecState
+{
+	AtomSpacePtr asp;
+	bool silent;
+	HandleSeq todo;
+	QueueValuePtr qvp;
+
+	std::atomic<size_t> next;
+	std::atomic<size_t> active;
+	std::mutex mtx;
+	std::exception_ptr error;
+};
+typedef std::shared_ptr<ExecState> ExecStatePtr;
+
+} // anonymous namespace
+
+// The work items are claimed one at a time, with an atomic counter,
+// so the tasks never contend for a lock. The last task to finish
+// closes the queue.
+static void exec_task(const ExecStatePtr& est)
 {
-	set_thread_name("atoms:execlink");
-	set_frame(AtomSpaceCast(as));
+	size_t ntodo = est->todo.size();
 	while (true)
 	{
-		Handle h;
-		if (not todo->try_get(h)) return;
-		if (not h->is_executable()) return;
+		size_t i = est->next++;
+		if (ntodo <= i) break;
+
+		const Handle& h = est->todo[i];
+		if (not h->is_executable()) break;
 
 		try
 		{
-			ValuePtr pap(h->execute(as, silent));
-			if (pap and pap->is_atom())
-				pap = as->add_atom(HandleCast(pap));
-			qvp->add(std::move(pap));
+			ValuePtr pap(h->execute(est->asp.get(), est->silent));
+			if (pap and pap->is_atom() and est->asp)
+				pap = est->asp->add_atom(HandleCast(pap));
+			est->qvp->add(std::move(pap));
 		}
-		catch (const std::exception& ex)
+		catch (...)
 		{
-			*returned_ex = std::current_exception();
-			return;
+			std::lock_guard<std::mutex> lck(est->mtx);
+			if (nullptr == est->error)
+				est->error = std::current_exception();
+			est->next = ntodo;
+			break;
 		}
 	}
+
+	if (0 < --est->active) return;
+	if (est->error)
+		est->qvp->fail(est->error);
+	else
+		est->qvp->close();
 }
 
-static void thread_joiner(AtomSpace* as, bool silent,
-                          Handle exlnk,
-                          size_t nthreads,
-                          QueueValuePtr qvp)
+ValuePtr ExecuteThreadedLink::execute(AtomSpace* as,
+                                      bool silent)
 {
-	// Place the work items onto a queue.
-	concurrent_queue<Handle> todo_list;
+	ExecStatePtr est(std::make_shared<ExecState>());
+	if (as) est->asp = AtomSpaceCast(as);
+	est->silent = silent;
+	est->qvp = createQueueValue();
+	est->next = 0;
+
+	// Place the work items onto a list.
 	bool chk = true;
-	for (const Handle& h: exlnk->getOutgoingSet())
+	for (const Handle& h: _outgoing)
 	{
 		if (chk and h->is_type(NUMBER_NODE)) continue;
 		chk = false;
 
 		if (not (SET_LINK == h->get_type()))
 		{
-			todo_list.push(h);
+			est->todo.push_back(h);
 			continue;
 		}
 
@@ -160,44 +182,23 @@ static void thread_joiner(AtomSpace* as, bool silent,
 		// I suspect that special-casing for SetLinks should be
 		// removed someday. Just not today.
 		for (const Handle& hs: h->getOutgoingSet())
-			todo_list.push(hs);
+			est->todo.push_back(hs);
 	}
 
-	std::exception_ptr ex;
-
-	// Launch the workers
-	std::vector<std::thread> thread_set;
-	for (size_t i=0; i<nthreads; i++)
+	size_t ntasks = std::min(_nthreads, est->todo.size());
+	if (0 == ntasks)
 	{
-		thread_set.push_back(std::thread(&thread_exec,
-			as, silent, &todo_list, qvp, &ex));
+		est->qvp->close();
+		return est->qvp;
 	}
 
-	// Wait for all threads to come together.
-	for (std::thread& t : thread_set) t.join();
-
-#if 0
-	// Were there any exceptions? If so, rethrow.
-	// XXX Wait, how ???
-	if (ex) std::rethrow_exception(ex);
-#endif
-
-	qvp->close();
-}
-
-ValuePtr ExecuteThreadedLink::execute(AtomSpace* as,
-                                      bool silent)
-{
-	// If a previous invocation is still running, wait for it
-	// to finish. This avoids memory management issues.
-	if (_joiner.joinable())
-		_joiner.join();
-
-	QueueValuePtr qvp(createQueueValue());
-
-	std::thread jnr(&thread_joiner,
-		as, silent, get_handle(), _nthreads, qvp);
-	_joiner.swap(jnr);
+	// Copy the pointer, as the last task might finish before
+	// the return.
+	QueueValuePtr qvp(est->qvp);
+	est->active = ntasks;
+	TaskPool& pool = TaskPool::instance();
+	for (size_t i=0; i<ntasks; i++)
+		pool.submit(est->asp, [est]() { exec_task(est); });
 
 	return qvp;
 }
@@ -21,13 +21,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-#include <thread>
-
-#include <opencog/util/platform.h>
 #include <opencog/atoms/parallel/ParallelLink.h>
+#include <opencog/atoms/parallel/TaskPool.h>
 #include <opencog/atoms/value/VoidValue.h>
 #include <opencog/atomspace/AtomSpace.h>
-#include <opencog/eval/FrameStack.h>
 
 using namespace opencog;
 
@@ -40,10 +37,6 @@ static void thread_eval(AtomSpace* as,
                         const Handle& evelnk,
                         bool silent)
 {
-	set_thread_name("atoms:parallel");
-	if (not evelnk->is_executable()) return;
-
-	set_frame(AtomSpaceCast(as));
 	try
 	{
 		ValuePtr pap(evelnk->execute(as, silent));
@@ -59,11 +52,15 @@ static void thread_eval(AtomSpace* as,
 ValuePtr ParallelLink::execute(AtomSpace* as,
                                bool silent)
 {
-	// Create and detach threads; return immediately.
+	// Hand off to the pool; return immediately. The tasks hold
+	// on to the AtomSpace, so that it outlives them.
+	AtomSpacePtr asp(AtomSpaceCast(as));
+	TaskPool& pool = TaskPool::instance();
 	for (const Handle& h : _outgoing)
 	{
-		std::thread thr(&thread_eval, as, h, silent);
-		thr.detach();
+		if (not h->is_executable()) continue;
+		pool.submit(asp, [asp, h, silent]()
+			{ thread_eval(asp.get(), h, silent); });
 	}
 
 	return createVoidValue();
@@ -0,0 +1,272 @@
+/*
+ * opencog/atoms/parallel/TaskPool.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Process-wide, work-stealing pool of threads for executing Atoms.
+ */
+
+#include <opencog/util/exceptions.h>
+#include <opencog/util/Logger.h>
+#include <opencog/util/platform.h>
+
+#include <opencog/atoms/parallel/TaskPool.h>
+#include <opencog/eval/FrameStack.h>
+
+using namespace opencog;
+
+thread_local size_t TaskPool::_worker_id = 0;
+
+// Parallel links are commonly used for tasks that block: sleeping,
+// waiting for input. The default allows for a fair number of these,
+// even on small machines.
+#define DEFAULT_SIZE std::max(16U, 2 * std::thread::hardware_concurrency())
+
+TaskPool& TaskPool::instance(void)
+{
+	// Never deleted. At exit, the workers may be in the middle of
+	// some task, and cannot be joined; they are just abandoned.
+	static TaskPool* pool = new TaskPool();
+	return *pool;
+}
+
+TaskPool::TaskPool(void) :
+	_ndeques(0),
+	_size(DEFAULT_SIZE),
+	_next(0),
+	_queued(0),
+	_running(0),
+	_completed(0),
+	_stolen(0)
+{
+	for (size_t i = 0; i < MAX_THREADS; i++)
+		_deques[i] = nullptr;
+}
+
+// ---------------------------------------------------------------
+
+/// Start one more worker. Caller must hold `_mtx`.
+void TaskPool::spawn(void)
+{
+	size_t wid = _threads.size();
+	if (_ndeques <= wid)
+	{
+		_deques[wid] = new Deque();
+		_ndeques = wid + 1;
+	}
+	_threads.emplace_back(&TaskPool::worker_loop, this, wid);
+}
+
+/// True if worker `wid` has been dropped by `resize()`. Caller must
+/// hold `_mtx`. A shrink followed by a grow puts a new thread into
+/// the same slot; the thread id tells the two apart.
+bool TaskPool::retired(size_t wid) const
+{
+	return _threads.size() <= wid or
+		_threads[wid].get_id() != std::this_thread::get_id();
+}
+
+void TaskPool::worker_loop(size_t wid)
+{
+	set_thread_name("atoms:taskpool");
+	_worker_id = wid + 1;
+
+	while (true)
+	{
+		Job job;
+		if (take(wid, job))
+		{
+			execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lck(_mtx);
+		if (retired(wid)) return;
+		_wake.wait(lck, [&]{ return 0 < _queued or retired(wid); });
+	}
+}
+
+// ---------------------------------------------------------------
+
+void TaskPool::push(Job&& job)
+{
+	if (0 == _ndeques)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (_threads.empty()) spawn();
+	}
+
+	size_t ndq = _ndeques;
+	size_t wid = in_worker() ? _worker_id - 1 : _next++ % ndq;
+	{
+		Deque& dq = *_deques[wid];
+		std::lock_guard<std::mutex> lck(dq.mtx);
+		dq.jobs.emplace_back(std::move(job));
+	}
+	_queued++;
+
+	// Taking the lock ensures that a worker that has just found
+	// nothing to do is already waiting, and so will be woken.
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (_threads.size() < _size and
+		    _threads.size() < _queued + _running)
+			spawn();
+	}
+	_wake.notify_one();
+}
+
+/// Get a job: from the back of our own deque, if there is one,
+/// else from the front of some other deque. Non-pool threads pass
+/// a `wid` of `MAX_THREADS`, and have no deque of their own.
+bool TaskPool::take(size_t wid, Job& job)
+{
+	size_t ndq = _ndeques;
+	if (wid < ndq)
+	{
+		Deque& dq = *_deques[wid];
+		std::lock_guard<std::mutex> lck(dq.mtx);
+		if (not dq.jobs.empty())
+		{
+			job = std::move(dq.jobs.back());
+			dq.jobs.pop_back();
+			_queued--;
+			return true;
+		}
+	}
+
+	if (0 == _queued) return false;
+
+	size_t start = (wid < ndq) ? wid + 1 : 0;
+	for (size_t i = 0; i < ndq; i++)
+	{
+		size_t victim = (start + i) % ndq;
+		if (victim == wid) continue;
+
+		Deque& dq = *_deques[victim];
+		std::lock_guard<std::mutex> lck(dq.mtx);
+		if (dq.jobs.empty()) continue;
+		job = std::move(dq.jobs.front());
+		dq.jobs.pop_front();
+		_queued--;
+		if (wid < ndq) _stolen++;
+		return true;
+	}
+	return false;
+}
+
+void TaskPool::execute(Job& job)
+{
+	_running++;
+	AtomSpacePtr saved(get_frame());
+	set_frame(job.frame);
+	try
+	{
+		job.task();
+	}
+	catch (const std::exception& ex)
+	{
+		logger().warn("Caught exception in task:\n%s", ex.what());
+	}
+	catch (...)
+	{
+		logger().warn("Caught unknown exception in task");
+	}
+	set_frame(saved);
+	_running--;
+	_completed++;
+}
+
+// ---------------------------------------------------------------
+
+void TaskPool::submit(const AtomSpacePtr& frame, Task&& task)
+{
+	push({frame, std::move(task)});
+}
+
+void TaskPool::run(const AtomSpacePtr& frame, std::vector<Task>&& tasks)
+{
+	if (tasks.empty()) return;
+
+	struct Group
+	{
+		std::mutex mtx;
+		std::condition_variable done;
+		size_t pending;
+		std::exception_ptr error;
+	};
+	auto grp = std::make_shared<Group>();
+	grp->pending = tasks.size();
+
+	for (Task& t : tasks)
+	{
+		push({frame, [grp, t = std::move(t)]()
+		{
+			std::exception_ptr err;
+			try { t(); }
+			catch (...) { err = std::current_exception(); }
+
+			std::lock_guard<std::mutex> lck(grp->mtx);
+			if (err and nullptr == grp->error) grp->error = err;
+			if (0 == --grp->pending) grp->done.notify_all();
+		}});
+	}
+
+	// Help out, until there is nothing left to take; then wait for
+	// the stragglers.
+	size_t wid = in_worker() ? _worker_id - 1 : MAX_THREADS;
+	std::unique_lock<std::mutex> lck(grp->mtx);
+	while (0 < grp->pending)
+	{
+		lck.unlock();
+		Job job;
+		bool got = take(wid, job);
+		if (got) execute(job);
+		lck.lock();
+		if (not got)
+			grp->done.wait(lck, [&]{ return 0 == grp->pending; });
+	}
+
+	if (grp->error) std::rethrow_exception(grp->error);
+}
+
+// ---------------------------------------------------------------
+
+void TaskPool::resize(size_t sz)
+{
+	if (in_worker())
+		throw RuntimeException(TRACE_INFO,
+			"Cannot resize the TaskPool from within one of its threads");
+
+	sz = std::min(std::max(sz, (size_t) 1), MAX_THREADS);
+
+	std::vector<std::thread> surplus;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_size = sz;
+		while (sz < _threads.size())
+		{
+			surplus.emplace_back(std::move(_threads.back()));
+			_threads.pop_back();
+		}
+	}
+	_wake.notify_all();
+	for (std::thread& t : surplus) t.join();
+}
+
+TaskPool::Stats TaskPool::get_stats(void) const
+{
+	Stats st;
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		st.threads = _threads.size();
+	}
+	st.queued = _queued;
+	st.running = _running;
+	st.completed = _completed;
+	st.stolen = _stolen;
+	return st;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,143 @@
+/*
+ * opencog/atoms/parallel/TaskPool.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Process-wide, work-stealing pool of threads for executing Atoms.
+ */
+
+#ifndef _OPENCOG_TASK_POOL_H
+#define _OPENCOG_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * TaskPool - a process-wide pool of worker threads, shared by
+ * ExecuteThreadedLink, ParallelLink and TriggerLink.
+ *
+ * Creating a thread costs far more than executing a typical small
+ * Atom, and so the threads are created once, as they are needed, and
+ * are then parked between tasks. Each worker has its own deque of
+ * tasks: it takes from the back of its own deque, and, when that is
+ * empty, steals from the front of the deques of the other workers.
+ * Tasks submitted from a worker go onto that worker's own deque;
+ * tasks submitted from elsewhere are dealt out round-robin.
+ *
+ * Each task runs with the frame (the current AtomSpace, as given by
+ * `get_frame()`) that it was submitted with. The frame of the thread
+ * running it is restored afterwards, so that a task never sees, nor
+ * leaks, the frame of some earlier task.
+ *
+ * The pool grows, up to `size()` threads, whenever there are more
+ * tasks queued or running than there are threads. Tasks that block
+ * for a long time (sleeping, waiting on I/O) each hold a thread for
+ * that long; the size should allow for this.
+ */
+class TaskPool
+{
+public:
+	typedef std::function<void(void)> Task;
+
+	/// Counters, for performance monitoring.
+	struct Stats
+	{
+		size_t threads;    // Threads in the pool.
+		size_t queued;     // Tasks waiting to run.
+		size_t running;    // Tasks running right now.
+		size_t completed;  // Tasks run to completion, or to a throw.
+		size_t stolen;     // Tasks taken from the deque of another worker.
+	};
+
+	static TaskPool& instance(void);
+
+	/// Run `task` in some pool thread, with `frame` as the current
+	/// AtomSpace. Returns immediately. Exceptions thrown by the task
+	/// are logged, and otherwise ignored; tasks that need to report
+	/// errors must catch them.
+	void submit(const AtomSpacePtr& frame, Task&& task);
+
+	/// Run all of the `tasks`, and wait for them to finish. The
+	/// calling thread helps out, running tasks from the pool until
+	/// these are done, so that this can be called from within a task
+	/// without deadlocking. The first exception thrown by any of the
+	/// tasks is rethrown here, after all of them have finished.
+	void run(const AtomSpacePtr& frame, std::vector<Task>&& tasks);
+
+	/// Set the maximum number of threads. When shrinking, this waits
+	/// for the surplus threads to finish the task they are on; the
+	/// tasks still queued for them are stolen by the others. Must not
+	/// be called from a pool thread.
+	void resize(size_t);
+	size_t size(void) const { return _size; }
+
+	Stats get_stats(void) const;
+
+	/// True if the current thread belongs to the pool.
+	static bool in_worker(void) { return 0 != _worker_id; }
+
+private:
+	struct Job
+	{
+		AtomSpacePtr frame;
+		Task task;
+	};
+
+	// The deque of one worker. Never freed, so that thieves can scan
+	// the deques without holding any lock but the deque's own.
+	struct Deque
+	{
+		std::mutex mtx;
+		std::deque<Job> jobs;
+	};
+
+	static constexpr size_t MAX_THREADS = 256;
+
+	TaskPool(void);
+
+	void push(Job&&);
+	bool take(size_t wid, Job&);
+	void execute(Job&);
+	void spawn(void);
+	void worker_loop(size_t);
+	bool retired(size_t) const;
+
+	// One plus the index of the worker; zero for non-pool threads.
+	static thread_local size_t _worker_id;
+
+	Deque* _deques[MAX_THREADS];
+	std::atomic<size_t> _ndeques;
+
+	// Guards the threads, and the sleeping workers.
+	mutable std::mutex _mtx;
+	std::condition_variable _wake;
+	std::vector<std::thread> _threads;
+	std::atomic<size_t> _size;
+
+	std::atomic<size_t> _next;
+	std::atomic<size_t> _queued;
+	std::atomic<size_t> _running;
+	std::atomic<size_t> _completed;
+	std::atomic<size_t> _stolen;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_TASK_POOL_H
@@ -16,6 +16,7 @@
  * GNU General Public License for more details.
  */
 
+#include <opencog/atoms/parallel/TaskPool.h>
 #include <opencog/atoms/parallel/TriggerLink.h>
 #include <opencog/util/exceptions.h>
 
@@ -44,12 +45,23 @@ ValuePtr TriggerLink::execute(AtomSpace* as, bool silent)
 	// I dunno. As I am writing this, this seems like an OK idea
 	// to run all of them, but this is just ... also ... pointless?
 	// Maybe stupid? Bad idea? I don't know...
+	// They are run only for their side effects, so run them in
+	// parallel, in the TaskPool. The last one waits for all of them,
+	// and the first exception any of them throws is rethrown here.
+	std::vector<TaskPool::Task> tasks;
 	for (size_t i=0; i<sz-1; i++)
 	{
-		if (_outgoing[i]->is_executable())
-			_outgoing[i]->execute(as, silent);
+		const Handle& h = _outgoing[i];
+		if (h->is_executable())
+			tasks.push_back([h, as, silent]() { h->execute(as, silent); });
 	}
 
+	if (1 == tasks.size())
+		tasks[0]();
+	else if (1 < tasks.size())
+		TaskPool::instance().run(as ? AtomSpaceCast(as) : nullptr,
+		                         std::move(tasks));
+
 	if (_outgoing[sz-1]->is_executable())
 		return _outgoing[sz-1]->execute(as, silent);
 
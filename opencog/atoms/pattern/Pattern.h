@@ -41,6 +41,8 @@ namespace opencog {
  *  @{
  */
 
+class GroundingCache;
+
 /// The Pattern struct contains a low-level analysis of a search pattern,
 /// in a format that will make a subsequent search run faster.  It is
 /// effectively a "compiled" version of the pattern. Patterns only need
@@ -132,6 +134,11 @@ struct Pattern
 	/// Used in conjunction with the `cacheable_multi` above.
 	std::map<PatternTermPtr, HandleSeq> clause_variables;
 
+	/// Groundings of the cacheable clauses, kept from one search to
+	/// the next. Null, unless asked for; see
+	/// `PatternLink::set_grounding_cache()`.
+	std::shared_ptr<GroundingCache> gnd_cache;
+
 	/// Any given atom may appear in one or more clauses. Given an atom,
 	/// the connectivy map tells you what clauses it appears in. It
 	/// captures how the clauses are connected to one-another, so that,
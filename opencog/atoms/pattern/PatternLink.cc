@@ -31,6 +31,7 @@
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/value/UnisetValue.h>
 #include <opencog/atomspace/AtomSpace.h>
+#include <opencog/query/GroundingCache.h>
 
 #include "DualLink.h"
 #include "PatternLink.h"
@@ -226,6 +227,23 @@ void PatternLink::setup_components(void)
 	}
 }
 
+/// Hand out a new, empty cache to this pattern, and to each of its
+/// components.
+void PatternLink::set_grounding_cache(size_t max_entries)
+{
+	if (0 == max_entries)
+		_pat.gnd_cache.reset();
+	else
+		_pat.gnd_cache = std::make_shared<GroundingCache>(_pat, max_entries);
+
+	for (const PatternParts& pp : _parts)
+	{
+		PatternLinkPtr plp(PatternLinkCast(pp._part_pattern));
+		if (plp and plp.get() != this)
+			plp->set_grounding_cache(max_entries);
+	}
+}
+
 /// A body that is an OrLink must be treated as a collection of
 /// distinct, unrelated searches. A body that is sequential must
 /// run the searches in sequence, and halt when satisfied.
@@ -185,6 +185,13 @@ public:
 
 	const PartsSeq& get_parts(void) const { return _parts; }
 
+	// Keep the groundings of cacheable clauses from one search to
+	// the next, for patterns that are run over and over, on an
+	// AtomSpace that changes slowly. At most `max_entries` are kept;
+	// zero turns this off, which is the default. Do not call while
+	// searches with this pattern are running.
+	void set_grounding_cache(size_t max_entries);
+
 	// Return the list virtual clauses we are holding.
 	const HandleSeq& get_virtual(void) const { return _virtual; }
 
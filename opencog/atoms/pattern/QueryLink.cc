@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/query/Implicator.h>
@@ -77,6 +78,18 @@ QueryLink::QueryLink(const HandleSeq&& hseq, Type t)
 	init();
 }
 
+QueryLink::~QueryLink()
+{
+	// A running stream holds a Handle to this Link, so we get here
+	// only after it is done, or from the streaming thread itself, as
+	// it lets go of that Handle.
+	if (not _streamer.joinable()) return;
+	if (_streamer.get_id() == std::this_thread::get_id())
+		_streamer.detach();
+	else
+		_streamer.join();
+}
+
 /* ================================================================= */
 /* ================================================================= */
 /**
@@ -135,7 +148,26 @@ ContainerValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 		throw RuntimeException(TRACE_INFO,
 			"Expecting QueueValue for results!");
 
+	// A bounded queue asks for the results to be streamed.
+	QueueValuePtr qvp(QueueValueCast(cvp));
+	if (qvp and 0 < qvp->get_capacity())
+	{
+		start_stream(as, qvp);
+		return cvp;
+	}
+
+	do_search(as, cvp, false);
+	return cvp;
+}
+
+/// Run the search, placing results into `cvp`. When streaming, the
+/// queue is already open, and the reader may be emptying it, or may
+/// have closed it.
+void QueryLink::do_search(AtomSpace* as, ContainerValuePtr& cvp,
+                          bool streaming)
+{
 	Implicator impl(as, cvp);
+	impl.streaming = streaming;
 
 	try
 	{
@@ -153,9 +185,18 @@ ContainerValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 	}
 
 	// If we got a non-empty answer, just return it.
-	OC_ASSERT(cvp->is_closed(), "Unexpected queue state!");
-	if (0 < cvp->size())
-		return cvp;
+	if (not streaming)
+	{
+		OC_ASSERT(cvp->is_closed(), "Unexpected queue state!");
+		if (0 < cvp->size())
+			return;
+	}
+	else
+	{
+		// Some of the results may have been read already.
+		if (cvp->is_closed() or 0 < QueueValueCast(cvp)->get_stats().count)
+			return;
+	}
 
 	// If we are here, then there were zero matches.
 	//
@@ -190,15 +231,51 @@ ContainerValuePtr QueryLink::do_execute(AtomSpace* as, bool silent)
 				cvp->add(himp);
 		}
 		cvp->close();
-		return cvp;
 	}
+}
 
-	return cvp;
+// The QueryLink being streamed by this thread, if any.
+static thread_local const QueryLink* streaming_query = nullptr;
+
+void QueryLink::start_stream(AtomSpace* as, const QueueValuePtr& qvp)
+{
+	// Stop any earlier stream into this same queue, and wait for it.
+	qvp->close();
+	if (_streamer.joinable())
+		_streamer.join();
+
+	// Empty the queue, and re-open it, which also resets the stats.
+	qvp->clear();
+	qvp->open();
+
+	Handle self(get_handle());
+	ContainerValuePtr cvp(qvp);
+	_streamer = std::thread([self, as, cvp]() mutable
+	{
+		QueryLinkPtr qlp(QueryLinkCast(self));
+		streaming_query = qlp.get();
+		try
+		{
+			qlp->do_search(as, cvp, true);
+		}
+		catch (const StandardException& ex)
+		{
+			logger().warn("QueryLink stream stopped: %s",
+			              ex.get_message());
+		}
+		catch (...) {}
+		streaming_query = nullptr;
+		cvp->close();
+	});
 }
 
 ValuePtr QueryLink::execute(AtomSpace* as, bool silent)
 {
 	if (_recursing) return get_handle();
+
+	// A rewrite that runs this same query, while it is streaming.
+	if (streaming_query == this) return get_handle();
+
 	_recursing = true;
 	ValuePtr vp(do_execute(as, silent));
 	_recursing = false;
@@ -22,8 +22,11 @@
 #ifndef _OPENCOG_QUERY_LINK_H
 #define _OPENCOG_QUERY_LINK_H
 
+#include <thread>
+
 #include <opencog/atoms/pattern/PatternLink.h>
 #include <opencog/atoms/value/ContainerValue.h>
+#include <opencog/atoms/value/QueueValue.h>
 
 namespace opencog
 {
@@ -34,10 +37,15 @@ class QueryLink : public PatternLink
 {
 private:
 	bool _recursing;
+	std::thread _streamer;
+
+	void start_stream(AtomSpace*, const QueueValuePtr&);
+
 protected:
 	void init(void);
 
 	virtual ContainerValuePtr do_execute(AtomSpace*, bool silent);
+	void do_search(AtomSpace*, ContainerValuePtr&, bool streaming);
 
 public:
 	QueryLink(const HandleSeq&&, Type=QUERY_LINK);
@@ -46,8 +54,21 @@ public:
 
 	QueryLink(const QueryLink&) = delete;
 	QueryLink& operator=(const QueryLink&) = delete;
+	virtual ~QueryLink();
 
 	virtual bool is_executable() const { return true; }
+
+	/// Run the query, placing the results into the container held at
+	/// this QueryLink, under itself as the key (see PatternLink), and
+	/// return that container.
+	///
+	/// If the container is a QueueValue with a capacity set, then the
+	/// results are streamed: the search runs in a thread of its own,
+	/// and the queue is returned at once, open. The search waits
+	/// whenever the queue is full. The reader may close the queue to
+	/// stop the search early; otherwise, the queue is closed when the
+	/// search is done. The QueueValue stats give the latency to the
+	/// first result, and the throughput.
 	virtual ValuePtr execute(AtomSpace*, bool silent=false);
 
 	static Handle factory(const Handle&);
@@ -11,6 +11,7 @@
 #include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/value/BoolValue.h>
 #include <opencog/atoms/value/LinkValue.h>
+#include <opencog/atoms/value/VectorKernels.h>
 #include "AccumulateLink.h"
 
 using namespace opencog;
@@ -44,6 +45,9 @@ void AccumulateLink::init(void)
 
 ValuePtr AccumulateLink::execute(AtomSpace* as, bool silent)
 {
+	ValuePtr vp(_program.run(get_handle(), as, silent));
+	if (vp) return vp;
+
 	ValuePtr vi(_outgoing[0]->execute(as, silent));
 	Type vitype = vi->get_type();
 
@@ -51,20 +55,14 @@ ValuePtr AccumulateLink::execute(AtomSpace* as, bool silent)
 	if (NUMBER_NODE == vitype)
 	{
 		const std::vector<double>& dvec(NumberNodeCast(vi)->value());
-		double acc = 0.0;
-		for (double dv : dvec)
-			acc += dv;
-		return createNumberNode(acc);
+		return createNumberNode(vec_sum(dvec.data(), dvec.size()));
 	}
 
 	// If its a float value, it's a vector. Sum.
 	if (nameserver().isA(vitype, FLOAT_VALUE))
 	{
 		const std::vector<double>& dvec(FloatValueCast(vi)->value());
-		double acc = 0.0;
-		for (double dv : dvec)
-			acc += dv;
-		return createFloatValue(acc);
+		return createFloatValue(vec_sum(dvec.data(), dvec.size()));
 	}
 
 	// XXX TODO -- we could also handle vectors of strings, by
@@ -101,7 +99,15 @@ ValuePtr AccumulateLink::execute(AtomSpace* as, bool silent)
 
 			if (acc.size() < dvec.size())
 				acc.resize(dvec.size());
-			acc = plus(acc, dvec);
+
+			// Same as acc = plus(acc, dvec), but without the copy.
+			// Note that plus() treats length-one vectors as scalars.
+			if (1 == dvec.size())
+				vec_plus(acc.data(), dvec[0], acc.data(), acc.size());
+			else if (1 < acc.size())
+				vec_plus(acc.data(), acc.data(), dvec.data(), dvec.size());
+			else
+				acc = plus(acc, dvec);
 		}
 		return createFloatValue(acc);
 	}
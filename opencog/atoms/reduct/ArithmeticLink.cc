@@ -160,6 +160,9 @@ Handle ArithmeticLink::reorder(void) const
 /// execute() -- Execute the expression
 ValuePtr ArithmeticLink::execute(AtomSpace* as, bool silent)
 {
+	ValuePtr vp(_program.run(get_handle(), as, silent));
+	if (vp) return vp;
+
 	return delta_reduce(as, silent);
 }
 
@@ -24,6 +24,7 @@
 #define _OPENCOG_ARITHMETIC_LINK_H
 
 #include <opencog/atoms/reduct/FoldLink.h>
+#include <opencog/atoms/reduct/NumericProgram.h>
 
 namespace opencog
 {
@@ -43,6 +44,9 @@ protected:
 	virtual Handle reorder(void) const;
 	bool _commutative;
 
+	// Compiled form of this expression, if it is closed.
+	NumericProgramCache _program;
+
 	// Execute the argument, and return the result of the execution.
 	static inline ValuePtr exec_for_value(AtomSpace* as, bool silent, const ValuePtr& vptr)
 	{
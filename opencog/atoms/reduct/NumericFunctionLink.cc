@@ -302,6 +302,9 @@ ValuePtr NumericFunctionLink::execute_binary(AtomSpace *as, bool silent)
 
 ValuePtr NumericFunctionLink::execute(AtomSpace* as, bool silent)
 {
+	ValuePtr vp(_program.run(get_handle(), as, silent));
+	if (vp) return vp;
+
 	if (1 == _outgoing.size())
 		return execute_unary(as, silent);
 	return execute_binary(as, silent);
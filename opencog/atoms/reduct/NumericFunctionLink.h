@@ -24,6 +24,7 @@
 #define _OPENCOG_NUMERIC_FUNCTION_LINK_H
 
 #include <opencog/atoms/core/FunctionLink.h>
+#include <opencog/atoms/reduct/NumericProgram.h>
 
 namespace opencog
 {
@@ -38,6 +39,9 @@ namespace opencog
 class NumericFunctionLink : public FunctionLink
 {
 protected:
+	// Compiled form of this expression, if it is closed.
+	NumericProgramCache _program;
+
 	void init();
 	ValuePtr execute_unary(AtomSpace*, bool);
 	ValuePtr execute_binary(AtomSpace*, bool);
@@ -0,0 +1,506 @@
+/*
+ * opencog/atoms/reduct/NumericProgram.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <cmath>
+#include <unordered_map>
+
+#include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/VectorKernels.h>
+
+#include "NumericProgram.h"
+
+using namespace opencog;
+
+namespace {
+
+// A vector of doubles, owned by someone else. `number` is true if the
+// interpreter would hold it in a NumberNode, and false if it would be
+// in a FloatValue.
+struct Slot
+{
+	const double* data;
+	size_t size;
+	bool number;
+};
+
+}
+
+// Same as in NumericFunctionLink.cc
+static double impulse(double x) { return 1-std::signbit(x); }
+
+// ---------------------------------------------------------------
+// The operations. Each of these mirrors what the interpreter does;
+// see the kons() methods and NumericFunctionLink::apply_func().
+// The output must not overlap the inputs. Return false if the
+// interpreter is needed.
+
+static bool compute(const NumericProgram::Insn& in,
+                    const Slot& a, const Slot& b, const Slot& c,
+                    std::vector<double>& out, std::vector<double>& tmp)
+{
+	switch (in.op)
+	{
+		case NumericProgram::PLUS:
+			// PlusLink::kons drops a plain zero on the right.
+			if (b.number and 1 == b.size and 0.0 == b.data[0] and
+			    not std::signbit(b.data[0]))
+				out.assign(a.data, a.data + a.size);
+			else
+				plus(out, a.data, a.size, b.data, b.size);
+			return true;
+
+		case NumericProgram::MINUS:
+			minus(out, a.data, a.size, b.data, b.size);
+			return true;
+
+		case NumericProgram::TIMES:
+			times(out, a.data, a.size, b.data, b.size);
+			return true;
+
+		case NumericProgram::DIVIDE:
+			divide(out, a.data, a.size, b.data, b.size);
+			return true;
+
+		case NumericProgram::TIMES_PLUS:
+			if (not a.number and not b.number and not c.number and
+			    a.size == b.size and a.size == c.size)
+			{
+				out.resize(a.size);
+				vec_times_plus(out.data(), a.data, b.data, c.data, a.size);
+				return true;
+			}
+			times(tmp, a.data, a.size, b.data, b.size);
+			{
+				Slot prod{tmp.data(), tmp.size(), a.number and b.number};
+				NumericProgram::Insn add{NumericProgram::PLUS};
+				return compute(add, prod, c, c, out, tmp);
+			}
+
+		case NumericProgram::POW:
+			if (0 == a.size or 0 == b.size) return false;
+			if (1 == a.size)
+			{
+				out.resize(b.size);
+				for (size_t i = 0; i < b.size; i++)
+					out[i] = pow(a.data[0], b.data[i]);
+			}
+			else if (1 == b.size)
+			{
+				out.resize(a.size);
+				for (size_t i = 0; i < a.size; i++)
+					out[i] = pow(a.data[i], b.data[0]);
+			}
+			else
+			{
+				out.resize(std::min(a.size, b.size));
+				for (size_t i = 0; i < out.size(); i++)
+					out[i] = pow(a.data[i], b.data[i]);
+			}
+			return true;
+
+		case NumericProgram::FUNC:
+			if (0 == a.size) return false;
+			out.resize(a.size);
+			for (size_t i = 0; i < a.size; i++)
+				out[i] = in.fun(a.data[i]);
+			return true;
+
+		case NumericProgram::SUM:
+			out.assign(1, vec_sum(a.data, a.size));
+			return true;
+	}
+	return false;
+}
+
+// Is the result of the operation held in a NumberNode?
+static bool is_number(const NumericProgram::Insn& in,
+                      const Slot& a, const Slot& b, const Slot& c)
+{
+	switch (in.op)
+	{
+		case NumericProgram::FUNC:
+		case NumericProgram::SUM:
+			return a.number;
+		case NumericProgram::TIMES_PLUS:
+			return a.number and b.number and c.number;
+		default:
+			return a.number and b.number;
+	}
+}
+
+// ---------------------------------------------------------------
+// Compiler
+
+namespace opencog {
+
+class NumericCompiler
+{
+	// During compilation, operands are numbered per kind; they are
+	// renumbered into slots at the end.
+	enum Kind { CONST, LEAF, REG };
+	struct Operand { Kind kind; size_t idx; };
+
+	struct Pending
+	{
+		NumericProgram::Insn insn;
+		Operand dst, a, b, c, tmp;
+	};
+
+	NumericProgram& _prog;
+	std::vector<Pending> _code;
+	std::unordered_map<Handle, size_t> _leaf_index;
+	std::vector<size_t> _free_regs;
+	size_t _nregs = 0;
+
+	struct Unsupported {};
+
+	Operand alloc(void)
+	{
+		if (_free_regs.empty()) return {REG, _nregs++};
+		size_t r = _free_regs.back();
+		_free_regs.pop_back();
+		return {REG, r};
+	}
+
+	void release(const Operand& o)
+	{
+		if (REG == o.kind) _free_regs.push_back(o.idx);
+	}
+
+	Slot const_slot(const Operand& o)
+	{
+		const std::vector<double>& v = _prog._consts[o.idx];
+		return {v.data(), v.size(), true};
+	}
+
+	Operand constant(std::vector<double>&& v)
+	{
+		_prog._consts.emplace_back(std::move(v));
+		return {CONST, _prog._consts.size() - 1};
+	}
+
+	Operand emit(NumericProgram::Op op, const Operand& a,
+	             const Operand& b, const Operand& c,
+	             double (*fun)(double) = nullptr)
+	{
+		NumericProgram::Insn in{op};
+		in.fun = fun;
+
+		// Fold constants now.
+		if (CONST == a.kind and CONST == b.kind and CONST == c.kind)
+		{
+			Slot sa(const_slot(a)), sb(const_slot(b)), sc(const_slot(c));
+			std::vector<double> out, tmp;
+			if (not compute(in, sa, sb, sc, out, tmp))
+				throw Unsupported();
+			return constant(std::move(out));
+		}
+
+		Operand dst(alloc());
+		Operand tmp{REG, 0};
+		if (NumericProgram::TIMES_PLUS == op) tmp = alloc();
+		release(a);
+		if (b.kind != a.kind or b.idx != a.idx) release(b);
+		if ((c.kind != a.kind or c.idx != a.idx) and
+		    (c.kind != b.kind or c.idx != b.idx)) release(c);
+		if (NumericProgram::TIMES_PLUS == op) release(tmp);
+
+		_code.push_back({in, dst, a, b, c, tmp});
+		return dst;
+	}
+
+	Operand emit(NumericProgram::Op op, const Operand& a,
+	             const Operand& b)
+	{
+		return emit(op, a, b, b);
+	}
+
+	static bool is_closed_leaf(const Handle& h)
+	{
+		for (const Handle& ho : h->getOutgoingSet())
+		{
+			if (not ho->is_node()) return false;
+			Type t = ho->get_type();
+			if (VARIABLE_NODE == t or GLOB_NODE == t) return false;
+		}
+		return true;
+	}
+
+	// The fold used by FoldLink::delta_reduce(): right to left.
+	Operand fold(NumericProgram::Op op, const HandleSeq& args)
+	{
+		if (0 == args.size()) throw Unsupported();
+
+		Operand acc(compile(args.back()));
+
+		// DivideLink::kons() divides the last argument by one; this
+		// turns empty vectors into a zero.
+		if (NumericProgram::DIVIDE == op)
+			acc = emit(op, acc, constant({1.0}));
+
+		for (size_t i = args.size() - 1; 0 < i; i--)
+			acc = emit(op, compile(args[i-1]), acc);
+		return acc;
+	}
+
+	// Same order as ArithmeticLink::reorder(), for closed expressions.
+	static HandleSeq reorder(const HandleSeq& oset)
+	{
+		HandleSeq exprs;
+		HandleSeq numbers;
+		for (const Handle& h : oset)
+		{
+			Type t = h->get_type();
+			if (SET_LINK == t) throw Unsupported();
+			if (NUMBER_NODE == t)
+				numbers.push_back(h);
+			else
+				exprs.push_back(h);
+		}
+		for (const Handle& h : numbers) exprs.push_back(h);
+		return exprs;
+	}
+
+	Operand compile(const Handle& h)
+	{
+		Type t = h->get_type();
+		if (NUMBER_NODE == t)
+		{
+			const std::vector<double>& v = NumberNodeCast(h)->value();
+			if (v.empty()) throw Unsupported();
+			return constant(std::vector<double>(v));
+		}
+		if (not h->is_link()) throw Unsupported();
+
+		const HandleSeq& oset = h->getOutgoingSet();
+
+		if (VALUE_OF_LINK == t or FLOAT_VALUE_OF_LINK == t)
+		{
+			if (not is_closed_leaf(h)) throw Unsupported();
+			auto it = _leaf_index.find(h);
+			if (it != _leaf_index.end()) return {LEAF, it->second};
+			_prog._leaves.push_back(h);
+			_leaf_index[h] = _prog._leaves.size() - 1;
+			return {LEAF, _prog._leaves.size() - 1};
+		}
+
+		if (PLUS_LINK == t)
+		{
+			// PlusLink::execute() fuses (Plus (Times a b) c).
+			if (2 == oset.size())
+			{
+				bool first = TIMES_LINK == oset[0]->get_type();
+				const Handle& ht = first ? oset[0] : oset[1];
+				if (TIMES_LINK == ht->get_type() and 2 == ht->get_arity())
+				{
+					Operand a(compile(ht->getOutgoingAtom(0)));
+					Operand b(compile(ht->getOutgoingAtom(1)));
+					Operand c(compile(first ? oset[1] : oset[0]));
+					return emit(NumericProgram::TIMES_PLUS, a, b, c);
+				}
+			}
+			return fold(NumericProgram::PLUS, reorder(oset));
+		}
+		if (TIMES_LINK == t)
+			return fold(NumericProgram::TIMES, reorder(oset));
+		if (MINUS_LINK == t)
+			return fold(NumericProgram::MINUS, oset);
+		if (DIVIDE_LINK == t)
+			return fold(NumericProgram::DIVIDE, oset);
+
+		if (POW_LINK == t and 2 == oset.size())
+		{
+			Operand a(compile(oset[0]));
+			return emit(NumericProgram::POW, a, compile(oset[1]));
+		}
+
+		if (1 != oset.size()) throw Unsupported();
+
+		if (ACCUMULATE_LINK == t)
+		{
+			Operand a(compile(oset[0]));
+			return emit(NumericProgram::SUM, a, a);
+		}
+
+		double (*fun)(double) = nullptr;
+		if (FLOOR_LINK == t) fun = floor;
+		else if (HEAVISIDE_LINK == t) fun = impulse;
+		else if (LOG2_LINK == t) fun = log2;
+		else if (SINE_LINK == t) fun = sin;
+		else if (COSINE_LINK == t) fun = cos;
+		else if (TAN_LINK == t) fun = tan;
+		else if (EXP_LINK == t) fun = exp;
+		else throw Unsupported();
+
+		Operand a(compile(oset[0]));
+		return emit(NumericProgram::FUNC, a, a, a, fun);
+	}
+
+	uint16_t slot(const Operand& o) const
+	{
+		size_t nconst = _prog._consts.size();
+		size_t nleaves = _prog._leaves.size();
+		if (CONST == o.kind) return o.idx;
+		if (LEAF == o.kind) return nconst + o.idx;
+		return nconst + nleaves + o.idx;
+	}
+
+public:
+	NumericCompiler(NumericProgram& prog) : _prog(prog) {}
+
+	bool run(const Handle& h)
+	{
+		Operand result;
+		try
+		{
+			result = compile(h);
+		}
+		catch (const Unsupported&)
+		{
+			return false;
+		}
+
+		if (UINT16_MAX < _prog._consts.size() + _prog._leaves.size() + _nregs)
+			return false;
+
+		_prog._nregs = _nregs;
+		_prog._result = slot(result);
+		for (const Pending& p : _code)
+		{
+			NumericProgram::Insn in(p.insn);
+			in.dst = slot(p.dst);
+			in.a = slot(p.a);
+			in.b = slot(p.b);
+			in.c = slot(p.c);
+			in.tmp = slot(p.tmp);
+			_prog._code.push_back(in);
+		}
+		return true;
+	}
+};
+
+}
+
+std::unique_ptr<NumericProgram> NumericProgram::compile(const Handle& h)
+{
+	std::unique_ptr<NumericProgram> prog(new NumericProgram());
+	NumericCompiler nc(*prog);
+	if (not nc.run(h)) return nullptr;
+	return prog;
+}
+
+// ---------------------------------------------------------------
+// Runtime
+
+namespace {
+
+// Registers and slots for one run. Executing a leaf can run another
+// program (a ValueOfLink may hold an executable Atom), and so there
+// is a stack of these, per thread.
+struct Frame
+{
+	std::vector<Slot> slots;
+	std::vector<std::vector<double>> regs;
+	ValueSeq hold;
+};
+
+thread_local std::vector<std::unique_ptr<Frame>> frames;
+thread_local size_t depth = 0;
+
+struct FrameGuard
+{
+	Frame* frame;
+	FrameGuard(void)
+	{
+		if (frames.size() == depth)
+			frames.emplace_back(new Frame());
+		frame = frames[depth++].get();
+	}
+	~FrameGuard()
+	{
+		for (ValuePtr& vp : frame->hold) vp = nullptr;
+		depth--;
+	}
+};
+
+}
+
+ValuePtr NumericProgram::run(AtomSpace* as, bool silent) const
+{
+	FrameGuard guard;
+	Frame& f = *guard.frame;
+
+	size_t nconst = _consts.size();
+	size_t nleaves = _leaves.size();
+	f.slots.resize(nconst + nleaves + _nregs);
+	if (f.regs.size() < _nregs) f.regs.resize(_nregs);
+	if (f.hold.size() < nleaves) f.hold.resize(nleaves);
+
+	for (size_t i = 0; i < nconst; i++)
+		f.slots[i] = {_consts[i].data(), _consts[i].size(), true};
+
+	for (size_t i = 0; i < nleaves; i++)
+	{
+		ValuePtr vp(_leaves[i]->execute(as, silent));
+		Type t = vp->get_type();
+		const std::vector<double>* v;
+		if (FLOAT_VALUE == t)
+			v = &FloatValueCast(vp)->value();
+		else if (NUMBER_NODE == t)
+			v = &NumberNodeCast(vp)->value();
+		else
+			return nullptr;
+		f.slots[nconst + i] = {v->data(), v->size(), NUMBER_NODE == t};
+		f.hold[i] = std::move(vp);
+	}
+
+	size_t rbase = nconst + nleaves;
+	for (const Insn& in : _code)
+	{
+		const Slot& a = f.slots[in.a];
+		const Slot& b = f.slots[in.b];
+		const Slot& c = f.slots[in.c];
+		std::vector<double>& out = f.regs[in.dst - rbase];
+		std::vector<double>& tmp = f.regs[in.tmp - rbase];
+		if (not compute(in, a, b, c, out, tmp))
+			return nullptr;
+		f.slots[in.dst] = {out.data(), out.size(), is_number(in, a, b, c)};
+	}
+
+	// The result register is handed over; it will be re-allocated on
+	// the next run.
+	const Slot& r = f.slots[_result];
+	std::vector<double> result;
+	if (rbase <= _result)
+		result.swap(f.regs[_result - rbase]);
+	else
+		result.assign(r.data, r.data + r.size);
+
+	if (r.number)
+		return createNumberNode(std::move(result));
+	return createFloatValue(std::move(result));
+}
+
+// ---------------------------------------------------------------
+
+ValuePtr NumericProgramCache::run(const Handle& h, AtomSpace* as,
+                                  bool silent)
+{
+#if USE_NUMERIC_PROGRAM
+	if (nullptr == h->getAtomSpace()) return nullptr;
+
+	std::call_once(_once, [&]() { _program = NumericProgram::compile(h); });
+	if (nullptr == _program) return nullptr;
+	return _program->run(as, silent);
+#else
+	return nullptr;
+#endif
+}
+
+/* ===================== END OF FILE ===================== */
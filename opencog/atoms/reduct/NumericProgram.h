@@ -0,0 +1,121 @@
+/*
+ * opencog/atoms/reduct/NumericProgram.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Compiled evaluation of closed arithmetic expressions.
+ */
+
+#ifndef _OPENCOG_NUMERIC_PROGRAM_H
+#define _OPENCOG_NUMERIC_PROGRAM_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+// Compile arithmetic expressions that are executed over and over.
+// Set to zero to always use the interpreter.
+#define USE_NUMERIC_PROGRAM 1
+
+/**
+ * A NumericProgram is a closed expression built from PlusLink,
+ * MinusLink, TimesLink, DivideLink, AccumulateLink, PowLink and the
+ * unary NumericFunctionLinks (Exp, Log2, Sine and so on), lowered to
+ * a flat list of instructions. The leaves are NumberNodes, which are
+ * folded into constants ahead of time, and ValueOfLinks and
+ * FloatValueOfLinks, which are executed each time the program runs.
+ *
+ * Running the program gives the same answer as executing the
+ * expression, but it does not create any intermediate Atoms or
+ * Values: the intermediate vectors live in per-thread registers that
+ * are reused from one run to the next. Only the final result is
+ * allocated.
+ *
+ * Anything that the interpreter would leave partly unreduced is not
+ * handled here: expressions holding variables or other Atom types do
+ * not compile, and a run gives up (returns nullptr) if a leaf turns
+ * out not to be a NumberNode or a plain FloatValue. The caller then
+ * falls back to the interpreter. This is safe, as the leaves have no
+ * side effects.
+ */
+class NumericProgram
+{
+public:
+	enum Op : uint8_t
+	{
+		PLUS, MINUS, TIMES, DIVIDE,
+		TIMES_PLUS,   // (Plus (Times a b) c); see PlusLink::execute
+		POW,
+		FUNC,         // Unary function, applied to each element.
+		SUM,          // AccumulateLink
+	};
+
+	// Operands are slot numbers. The constants come first, then the
+	// leaves, then the registers.
+	struct Insn
+	{
+		Op op;
+		uint16_t dst;
+		uint16_t a;
+		uint16_t b;
+		uint16_t c;
+		uint16_t tmp;
+		double (*fun)(double);
+	};
+
+private:
+	friend class NumericCompiler;
+
+	std::vector<std::vector<double>> _consts;
+	HandleSeq _leaves;
+	std::vector<Insn> _code;
+	size_t _nregs;
+	uint16_t _result;
+
+	NumericProgram(void) : _nregs(0), _result(0) {}
+
+public:
+	/// Compile the expression; return nullptr if it cannot be.
+	static std::unique_ptr<NumericProgram> compile(const Handle&);
+
+	/// Run the program; return nullptr if the interpreter is needed.
+	ValuePtr run(AtomSpace*, bool silent) const;
+
+	size_t size(void) const { return _code.size(); }
+	const HandleSeq& get_leaves(void) const { return _leaves; }
+};
+
+/**
+ * The compiled form of an expression, made on first use. This is held
+ * by the top-most Link of the expression. Only Links that are in an
+ * AtomSpace are compiled; these are the ones that get executed over
+ * and over. Short-lived Links, such as those made during reduction,
+ * are interpreted.
+ */
+class NumericProgramCache
+{
+	std::once_flag _once;
+	std::unique_ptr<NumericProgram> _program;
+
+public:
+	/// Run the compiled form of the Atom. Return nullptr if there is
+	/// none, or if the interpreter must be used for this particular run.
+	ValuePtr run(const Handle&, AtomSpace*, bool silent);
+};
+
+/** @}*/
+}
+
+#endif // _OPENCOG_NUMERIC_PROGRAM_H
@@ -9,6 +9,9 @@
 #include <opencog/atoms/atom_types/atom_types.h>
 #include <opencog/atoms/base/ClassServer.h>
 #include <opencog/atoms/core/NumberNode.h>
+#include <opencog/atoms/flow/ValueShimLink.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/VectorKernels.h>
 #include "MinusLink.h"
 #include "PlusLink.h"
 #include "TimesLink.h"
@@ -231,6 +234,73 @@ ValuePtr PlusLink::kons(AtomSpace* as, bool silent,
 	return createPlusLink(hi, hj);
 }
 
+// ============================================================
+
+/// Special case for `(Plus (Times a b) c)` on FloatValues of equal
+/// length: compute a*b+c in one pass, without creating the
+/// intermediate product. This is the common form of weighted sums in
+/// feature pipelines.
+ValuePtr PlusLink::execute(AtomSpace* as, bool silent)
+{
+	ValuePtr vp(_program.run(get_handle(), as, silent));
+	if (vp) return vp;
+
+	if (PLUS_LINK != get_type() or 2 != _outgoing.size())
+		return delta_reduce(as, silent);
+
+	bool times_first = TIMES_LINK == _outgoing[0]->get_type();
+	const Handle& ht = times_first ? _outgoing[0] : _outgoing[1];
+	if (TIMES_LINK != ht->get_type() or 2 != ht->get_arity())
+		return delta_reduce(as, silent);
+
+	const Handle& hc = times_first ? _outgoing[1] : _outgoing[0];
+	return times_plus(as, silent, ht->getOutgoingAtom(0),
+	                  ht->getOutgoingAtom(1), hc, times_first);
+}
+
+ValuePtr PlusLink::times_plus(AtomSpace* as, bool silent,
+                              const Handle& ha, const Handle& hb,
+                              const Handle& hc, bool times_first)
+{
+	// Evaluate in the same order that the fold would: right to left.
+	ValuePtr va, vb, vc;
+	if (times_first) vc = hc->execute(as, silent);
+	vb = hb->execute(as, silent);
+	va = ha->execute(as, silent);
+	if (not times_first) vc = hc->execute(as, silent);
+
+	// Exactly FloatValue; streams update themselves, and so are left
+	// to the general case.
+	if (FLOAT_VALUE == va->get_type() and
+	    FLOAT_VALUE == vb->get_type() and
+	    FLOAT_VALUE == vc->get_type())
+	{
+		const std::vector<double>& a = FloatValueCast(va)->value();
+		const std::vector<double>& b = FloatValueCast(vb)->value();
+		const std::vector<double>& c = FloatValueCast(vc)->value();
+		size_t len = a.size();
+		if (b.size() == len and c.size() == len)
+		{
+			std::vector<double> out(len);
+			vec_times_plus(out.data(), a.data(), b.data(), c.data(), len);
+			return createFloatValue(std::move(out));
+		}
+	}
+
+	// Anything else goes through the general case. The arguments have
+	// already been executed; avoid running them a second time, as they
+	// may have side effects. Atoms are returned as-is; Values need a
+	// shim.
+	auto shim = [](const ValuePtr& v) -> Handle {
+		if (v->is_atom()) return HandleCast(v);
+		return HandleCast(createValueShimLink(v));
+	};
+	Handle prod(createTimesLink(shim(va), shim(vb)));
+	Handle sum(times_first ?
+		createPlusLink(prod, shim(vc)) : createPlusLink(shim(vc), prod));
+	return PlusLinkCast(sum)->ArithmeticLink::execute(as, silent);
+}
+
 DEFINE_LINK_FACTORY(PlusLink, PLUS_LINK);
 
 // ============================================================
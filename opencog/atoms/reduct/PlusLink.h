@@ -28,6 +28,8 @@ protected:
 	                      const ValuePtr&, const ValuePtr&) const;
 
 	void init(void);
+	ValuePtr times_plus(AtomSpace*, bool, const Handle&, const Handle&,
+	                    const Handle&, bool);
 
 public:
 	PlusLink(const Handle& a, const Handle& b);
@@ -36,6 +38,8 @@ public:
 	PlusLink(const PlusLink&) = delete;
 	PlusLink& operator=(const PlusLink&) = delete;
 
+	virtual ValuePtr execute(AtomSpace*, bool);
+
 	static Handle factory(const Handle&);
 };
 
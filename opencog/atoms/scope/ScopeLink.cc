@@ -21,6 +21,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <string>
 
 #include <opencog/util/random.h>
@@ -318,22 +319,155 @@ bool ScopeLink::is_equal(const Handle& other, bool silent) const
 		return true;
 	}
 
-	// If we are here, we need to perform alpha conversion to test
-	// equality.  Other terms, with our variables in place of its
-	// variables, should be same as our terms.
+	// If we are here, the variable names differ. Walk both sides in
+	// step, comparing bound variables by their position, exactly as
+	// they are hashed (see term_hash() below). This does not create
+	// any Atoms, and so does not need to alpha-convert inner scopes.
+	const FreeVariables::IndexMap& other_index(scother->_variables.index);
 	for (Arity i = 0; i < n_scoped_terms; ++i)
 	{
-		Handle h = getOutgoingAtom(i + vardecl_offset);
-		Handle other_h = other->getOutgoingAtom(i + other_vardecl_offset);
-		other_h = scother->_variables.substitute_nocheck(other_h,
-		                                                 _variables.varseq, silent);
-		// Compare them, they should match.
-		if (*h != *other_h) return false;
+		const Handle& h(_outgoing[i + vardecl_offset]);
+		const Handle& other_h(other->getOutgoingAtom(i + other_vardecl_offset));
+		if (not term_equal(h, other_h, _variables.index, other_index))
+			return false;
 	}
 
 	return true;
 }
 
+/// Like is_equal(), but for a scope nested in the body of another,
+/// with the variables of the outer scopes already numbered.
+bool ScopeLink::scope_equal(const ScopeLink& other,
+                            const FreeVariables::IndexMap& index,
+                            const FreeVariables::IndexMap& other_index) const
+{
+	if (other.get_type() != _type) return false;
+
+	Arity vardecl_offset = _vardecl != Handle::UNDEFINED;
+	Arity other_vardecl_offset = other._vardecl != Handle::UNDEFINED;
+	Arity n_scoped_terms = get_arity() - vardecl_offset;
+	if (n_scoped_terms != other.get_arity() - other_vardecl_offset)
+		return false;
+
+	if (not _variables.is_equal(other._variables)) return false;
+
+	const HandleSeq& otho(other.getOutgoingSet());
+	for (Arity i = 0; i < n_scoped_terms; ++i)
+	{
+		if (not term_equal(_outgoing[i + vardecl_offset],
+		                   otho[i + other_vardecl_offset],
+		                   index, other_index))
+			return false;
+	}
+	return true;
+}
+
+/// Number the variables of an inner scope after those of the scopes
+/// enclosing it (these are de Bruijn levels). An inner variable may
+/// shadow an outer one of the same name; the shadowed level is then
+/// no longer in the map, and so the next free level is one past the
+/// largest one in use, rather than the size of the map.
+static FreeVariables::IndexMap
+extend_index(const FreeVariables::IndexMap& index, const Variables& vars)
+{
+	unsigned int base = 0;
+	for (const auto& vi : index)
+		base = std::max(base, vi.second + 1);
+
+	FreeVariables::IndexMap new_index(index);
+	for (const auto& vi : vars.index)
+		new_index[vi.first] = vi.second + base;
+	return new_index;
+}
+
+/// Recursive helper for is_equal(). This follows term_hash() step
+/// for step, so that two terms are equal only if their hashes are.
+bool ScopeLink::term_equal(const Handle& h, const Handle& other_h,
+                           const FreeVariables::IndexMap& index,
+                           const FreeVariables::IndexMap& other_index,
+                           Quotation quotation) const
+{
+	Type t = h->get_type();
+	if (other_h->get_type() != t) return false;
+
+	if ((VARIABLE_NODE == t or GLOB_NODE == t) and quotation.is_unquoted())
+	{
+		auto it = index.find(h);
+		auto oit = other_index.find(other_h);
+		bool bound = it != index.end();
+		if (bound != (oit != other_index.end())) return false;
+		if (bound) return it->second == oit->second;
+
+		// Free on both sides; these must be the same variable.
+	}
+
+	if (h->is_node()) return h == other_h or *h == *other_h;
+
+	if (h->get_arity() != other_h->get_arity()) return false;
+
+	if (nameserver().isA(t, SCOPE_LINK) and quotation.is_unquoted())
+	{
+		ScopeLinkPtr sco(ScopeLinkCast(h));
+		ScopeLinkPtr osc(ScopeLinkCast(other_h));
+		return sco->scope_equal(*osc,
+			extend_index(index, sco->_variables),
+			extend_index(other_index, osc->_variables));
+	}
+
+	quotation.update(t);
+
+	const HandleSeq& oset(h->getOutgoingSet());
+	const HandleSeq& other_oset(other_h->getOutgoingSet());
+	size_t sz = oset.size();
+	if (not h->is_unordered_link() or sz < 2)
+	{
+		for (size_t i = 0; i < sz; i++)
+			if (not term_equal(oset[i], other_oset[i],
+			                   index, other_index, quotation))
+				return false;
+		return true;
+	}
+
+	// Unordered links are sorted by the plain hash of their members,
+	// which depends on the variable names. Pair up the members by
+	// their alpha-invariant hash, instead. Members having the same
+	// hash are tried against one another; alpha-equivalence being an
+	// equivalence relation, taking the first match found is enough.
+	typedef std::pair<ContentHash, size_t> Member;
+	std::vector<Member> mine, theirs;
+	mine.reserve(sz);
+	theirs.reserve(sz);
+	for (size_t i = 0; i < sz; i++)
+	{
+		mine.emplace_back(term_hash(oset[i], index, quotation), i);
+		theirs.emplace_back(term_hash(other_oset[i], other_index, quotation), i);
+	}
+	std::sort(mine.begin(), mine.end());
+	std::sort(theirs.begin(), theirs.end());
+
+	for (size_t i = 0; i < sz; i++)
+		if (mine[i].first != theirs[i].first) return false;
+
+	std::vector<bool> used(sz, false);
+	for (size_t i = 0; i < sz; i++)
+	{
+		bool found = false;
+		for (size_t j = i; j < sz and theirs[j].first == mine[i].first; j++)
+		{
+			if (used[j]) continue;
+			if (term_equal(oset[mine[i].second], other_oset[theirs[j].second],
+			               index, other_index, quotation))
+			{
+				used[j] = true;
+				found = true;
+				break;
+			}
+		}
+		if (not found) return false;
+	}
+	return true;
+}
+
 /* ================================================================= */
 
 /// A specialized hashing function, designed so that all alpha-
@@ -366,19 +500,22 @@ ContentHash ScopeLink::scope_hash(const FreeVariables::IndexMap& index) const
 	fnv1a_hash(hsh, get_type());
 	fnv1a_hash(hsh, _variables.varseq.size());
 
-	// It is not safe to mix here, since the sort order of the
-	// typemaps will depend on the variable names. So must be
-	// abelian. That is, we must use addition.
-	ContentHash vth = 0;
-	for (const auto& pr : _variables._typemap)
+	// The type restrictions go with the position of the variable,
+	// as in Variables::is_equal(), and not with its name. Otherwise,
+	// swapping the types of two variables would not change the hash.
+	const HandleSeq& varseq(_variables.varseq);
+	for (size_t i = 0; i < varseq.size(); i++)
 	{
+		auto pr = _variables._typemap.find(varseq[i]);
+		if (_variables._typemap.end() == pr) continue;
+
 		// Semantic equivalence: an untyped variable is
 		// equivalent to a typed variable of type "ATOM".
-		if (pr.second->is_untyped()) continue;
+		if (pr->second->is_untyped()) continue;
 
-		vth += pr.second->get_typedecl()->get_hash();
+		fnv1a_hash(hsh, i);
+		fnv1a_hash(hsh, pr->second->get_typedecl()->get_hash());
 	}
-	fnv1a_hash(hsh, vth);
 
 	// As to not mix together VariableList and VariableSet
 	fnv1a_hash(hsh, _variables._ordered);
@@ -432,13 +569,8 @@ ContentHash ScopeLink::term_hash(const Handle& h,
 	// https://github.com/opencog/atomspace/issues/2507
 	if (nameserver().isA(t, SCOPE_LINK) and quotation.is_unquoted())
 	{
-		FreeVariables::IndexMap new_index(index);
 		ScopeLinkPtr sco(ScopeLinkCast(h));
-		const Variables& sco_vars = sco->get_variables();
-		const FreeVariables::IndexMap& sco_index = sco_vars.index;
-		for (const auto& vi : sco_index)
-			new_index[vi.first] = vi.second + index.size();
-		return sco->scope_hash(new_index);
+		return sco->scope_hash(extend_index(index, sco->get_variables()));
 	}
 
 	// Otherwise h is a regular link, recursively calculate its hash
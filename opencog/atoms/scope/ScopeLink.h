@@ -74,6 +74,14 @@ protected:
 	                      const FreeVariables::IndexMap& index,
 	                      Quotation quotation = Quotation()) const;
 
+	bool scope_equal(const ScopeLink&,
+	                 const FreeVariables::IndexMap& index,
+	                 const FreeVariables::IndexMap& other_index) const;
+	bool term_equal(const Handle&, const Handle&,
+	                const FreeVariables::IndexMap& index,
+	                const FreeVariables::IndexMap& other_index,
+	                Quotation quotation = Quotation()) const;
+
 public:
 	ScopeLink(const HandleSeq&&, Type=SCOPE_LINK);
 	ScopeLink(const Handle& varcdecls, const Handle& body);
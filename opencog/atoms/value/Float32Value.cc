@@ -23,6 +23,7 @@
 #include <opencog/util/exceptions.h>
 #include <opencog/atoms/value/Float32Value.h>
 #include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/atoms/value/VectorKernels.h>
 
 using namespace opencog;
 
@@ -36,8 +37,7 @@ ValuePtr Float32Value::incrementCount(const std::vector<float>& v) const
 		new_vect.resize(v.size(), 0.0f);
 
 	// Increment
-	for (size_t idx=0; idx < new_vect.size(); idx++)
-		new_vect[idx] += v[idx];
+	vec_plus(new_vect.data(), new_vect.data(), v.data(), v.size());
 
 	// Return a brand new value of the same type.
 	return valueserver().create(_type, std::move(new_vect));
@@ -102,61 +102,46 @@ std::string Float32Value::to_string(const std::string& indent, Type t) const
 /// Scalar addition
 std::vector<float> opencog::plus(float scalar, const std::vector<float>& fv)
 {
-	size_t len = fv.size();
-	std::vector<float> sum(len);
-	for (size_t i=0; i<len; i++)
-		sum[i] = scalar + fv[i];
-
+	std::vector<float> sum(fv.size());
+	vec_plus(sum.data(), scalar, fv.data(), fv.size());
 	return sum;
 }
 
 /// Scalar subtraction
 std::vector<float> opencog::minus(float scalar, const std::vector<float>& fv)
 {
-	size_t len = fv.size();
-	std::vector<float> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = scalar - fv[i];
-
+	std::vector<float> diff(fv.size());
+	vec_minus(diff.data(), scalar, fv.data(), fv.size());
 	return diff;
 }
 
 std::vector<float> opencog::minus(const std::vector<float>& fv, float scalar)
 {
-	size_t len = fv.size();
-	std::vector<float> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = fv[i] - scalar;
-
+	std::vector<float> diff(fv.size());
+	vec_minus(diff.data(), fv.data(), scalar, fv.size());
 	return diff;
 }
 
 /// Scalar multiplication
 std::vector<float> opencog::times(float scalar, const std::vector<float>& fv)
 {
-	size_t len = fv.size();
-	std::vector<float> prod(len);
-	for (size_t i=0; i<len; i++)
-		prod[i] = scalar * fv[i];
-
+	std::vector<float> prod(fv.size());
+	vec_times(prod.data(), scalar, fv.data(), fv.size());
 	return prod;
 }
 
 /// Scalar division
 std::vector<float> opencog::divide(float scalar, const std::vector<float>& fv)
 {
-	size_t len = fv.size();
-	std::vector<float> ratio(len);
-	for (size_t i=0; i<len; i++)
-		ratio[i] = scalar / fv[i];
-
+	std::vector<float> ratio(fv.size());
+	vec_divide(ratio.data(), scalar, fv.data(), fv.size());
 	return ratio;
 }
 
 /// Vector (point-wise) addition
 /// The shorter vector is assumed to be zero-padded.
 std::vector<float> opencog::plus(const std::vector<float>& fva,
-                                  const std::vector<float>& fvb)
+                                 const std::vector<float>& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
@@ -168,29 +153,19 @@ std::vector<float> opencog::plus(const std::vector<float>& fva,
 		return plus(fvb[0], fva);
 
 	std::vector<float> sum(std::max(lena, lenb));
+	size_t len = std::min(lena, lenb);
+	vec_plus(sum.data(), fva.data(), fvb.data(), len);
 	if (lena < lenb)
-	{
-		size_t i=0;
-		for (; i<lena; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lenb; i++)
-			sum[i] = fvb[i];
-	}
+		std::copy(fvb.begin() + len, fvb.end(), sum.begin() + len);
 	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lena; i++)
-			sum[i] = fva[i];
-	}
+		std::copy(fva.begin() + len, fva.end(), sum.begin() + len);
 	return sum;
 }
 
 /// Vector (point-wise) subtraction
 /// The shorter vector is assumed to be zero-padded.
 std::vector<float> opencog::minus(const std::vector<float>& fva,
-                                   const std::vector<float>& fvb)
+                                  const std::vector<float>& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
@@ -202,22 +177,15 @@ std::vector<float> opencog::minus(const std::vector<float>& fva,
 		return minus(fva, fvb[0]);
 
 	std::vector<float> diff(std::max(lena, lenb));
+	size_t len = std::min(lena, lenb);
+	vec_minus(diff.data(), fva.data(), fvb.data(), len);
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lenb; i++)
+		for (size_t i=len; i<lenb; i++)
 			diff[i] = -fvb[i];
 	}
 	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lena; i++)
-			diff[i] = fva[i];
-	}
+		std::copy(fva.begin() + len, fva.end(), diff.begin() + len);
 	return diff;
 }
 
@@ -229,41 +197,25 @@ std::vector<float> opencog::minus(const std::vector<float>& fva,
 /// the callers to this routine, or we could just handle it here.
 /// This may seem messy to you, but this is the easiest solution.
 std::vector<float> opencog::times(const std::vector<float>& fva,
-                                   const std::vector<float>& fvb)
+                                  const std::vector<float>& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
 
 	std::vector<float> prod(std::max(lena, lenb));
 	if (1 == lena)
-	{
-		float f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			prod[i] = f * fvb[i];
-	}
+		vec_times(prod.data(), fva[0], fvb.data(), lenb);
 	else
 	if (1 == lenb)
-	{
-		float f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			prod[i] = f * fva[i];
-	}
-	else
-	if (lena < lenb)
-	{
-		size_t i=0;
-		for (; i<lena; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lenb; i++)
-			prod[i] = fvb[i];
-	}
+		vec_times(prod.data(), fvb[0], fva.data(), lena);
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lena; i++)
-			prod[i] = fva[i];
+		size_t len = std::min(lena, lenb);
+		vec_times(prod.data(), fva.data(), fvb.data(), len);
+		if (lena < lenb)
+			std::copy(fvb.begin() + len, fvb.end(), prod.begin() + len);
+		else
+			std::copy(fva.begin() + len, fva.end(), prod.begin() + len);
 	}
 	return prod;
 }
@@ -273,41 +225,25 @@ std::vector<float> opencog::times(const std::vector<float>& fva,
 /// If the shorter vector has length one, assume its a scalar.
 /// See comments on times() above about scalars.
 std::vector<float> opencog::divide(const std::vector<float>& fva,
-                                    const std::vector<float>& fvb)
+                                   const std::vector<float>& fvb)
 {
 	size_t lena = fva.size();
 	size_t lenb = fvb.size();
 
 	std::vector<float> ratio(std::max(lena, lenb));
 	if (1 == lena)
-	{
-		float f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			ratio[i] = f / fvb[i];
-	}
+		vec_divide(ratio.data(), fva[0], fvb.data(), lenb);
 	else
 	if (1 == lenb)
-	{
-		float f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			ratio[i] = fva[i] / f;
-	}
-	else
-	if (lena < lenb)
-	{
-		size_t i=0;
-		for (; i<lena; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lenb; i++)
-			ratio[i] = 1.0f / fvb[i];
-	}
+		vec_divide(ratio.data(), fva.data(), fvb[0], lena);
 	else
 	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lena; i++)
-			ratio[i] = fva[i];
+		size_t len = std::min(lena, lenb);
+		vec_divide(ratio.data(), fva.data(), fvb.data(), len);
+		if (lena < lenb)
+			vec_divide(ratio.data() + len, 1.0f, fvb.data() + len, lenb - len);
+		else
+			std::copy(fva.begin() + len, fva.end(), ratio.begin() + len);
 	}
 	return ratio;
 }
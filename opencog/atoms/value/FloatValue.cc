@@ -23,6 +23,7 @@
 #include <opencog/util/exceptions.h>
 #include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atoms/value/ValueFactory.h>
+#include <opencog/atoms/value/VectorKernels.h>
 
 using namespace opencog;
 
@@ -36,8 +37,7 @@ ValuePtr FloatValue::incrementCount(const std::vector<double>& v) const
 		new_vect.resize(v.size(), 0.0);
 
 	// Increment
-	for (size_t idx=0; idx < new_vect.size(); idx++)
-		new_vect[idx] += v[idx];
+	vec_plus(new_vect.data(), new_vect.data(), v.data(), v.size());
 
 	// Return a brand new value of the same type.
 	return valueserver().create(_type, std::move(new_vect));
@@ -59,6 +59,22 @@ ValuePtr FloatValue::incrementCount(size_t idx, double count) const
 	return valueserver().create(_type, std::move(new_vect));
 }
 
+void FloatValue::add_in_place(const std::vector<double>& v)
+{
+	if (_value.size() < v.size())
+		_value.resize(v.size(), 0.0);
+
+	vec_plus(_value.data(), _value.data(), v.data(), v.size());
+}
+
+void FloatValue::add_in_place(size_t idx, double count)
+{
+	if (_value.size() <= idx)
+		_value.resize(idx+1, 0.0);
+
+	_value[idx] += count;
+}
+
 bool FloatValue::operator==(const Value& other) const
 {
 	// Unlike Atoms, we are willing to compare other types, as long
@@ -168,123 +184,101 @@ std::string FloatValue::to_string(const std::string& indent, Type t) const
 /// Scalar addition
 std::vector<double> opencog::plus(double scalar, const std::vector<double>& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> sum(len);
-	for (size_t i=0; i<len; i++)
-		sum[i] = scalar + fv[i];
-
+	std::vector<double> sum(fv.size());
+	vec_plus(sum.data(), scalar, fv.data(), fv.size());
 	return sum;
 }
 
 /// Scalar subtraction
 std::vector<double> opencog::minus(double scalar, const std::vector<double>& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = scalar - fv[i];
-
+	std::vector<double> diff(fv.size());
+	vec_minus(diff.data(), scalar, fv.data(), fv.size());
 	return diff;
 }
 
 std::vector<double> opencog::minus(const std::vector<double>& fv, double scalar)
 {
-	size_t len = fv.size();
-	std::vector<double> diff(len);
-	for (size_t i=0; i<len; i++)
-		diff[i] = fv[i] - scalar;
-
+	std::vector<double> diff(fv.size());
+	vec_minus(diff.data(), fv.data(), scalar, fv.size());
 	return diff;
 }
 
 /// Scalar multiplication
 std::vector<double> opencog::times(double scalar, const std::vector<double>& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> prod(len);
-	for (size_t i=0; i<len; i++)
-		prod[i] = scalar * fv[i];
-
+	std::vector<double> prod(fv.size());
+	vec_times(prod.data(), scalar, fv.data(), fv.size());
 	return prod;
 }
 
 /// Scalar division
 std::vector<double> opencog::divide(double scalar, const std::vector<double>& fv)
 {
-	size_t len = fv.size();
-	std::vector<double> ratio(len);
-	for (size_t i=0; i<len; i++)
-		ratio[i] = scalar / fv[i];
-
+	std::vector<double> ratio(fv.size());
+	vec_divide(ratio.data(), scalar, fv.data(), fv.size());
 	return ratio;
 }
 
 /// Vector (point-wise) addition
 /// The shorter vector is assumed to be zero-padded.
-std::vector<double> opencog::plus(const std::vector<double>& fva,
-                                  const std::vector<double>& fvb)
+void opencog::plus(std::vector<double>& sum,
+                   const double* fva, size_t lena,
+                   const double* fvb, size_t lenb)
 {
-	size_t lena = fva.size();
-	size_t lenb = fvb.size();
-
 	if (1 == lena)
-		return plus(fva[0], fvb);
+	{
+		sum.resize(lenb);
+		vec_plus(sum.data(), fva[0], fvb, lenb);
+		return;
+	}
 
 	if (1 == lenb)
-		return plus(fvb[0], fva);
-
-	std::vector<double> sum(std::max(lena, lenb));
-	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lenb; i++)
-			sum[i] = fvb[i];
+		sum.resize(lena);
+		vec_plus(sum.data(), fvb[0], fva, lena);
+		return;
 	}
+
+	sum.resize(std::max(lena, lenb));
+	size_t len = std::min(lena, lenb);
+	vec_plus(sum.data(), fva, fvb, len);
+	if (lena < lenb)
+		std::copy(fvb + len, fvb + lenb, sum.begin() + len);
 	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			sum[i] = fva[i] + fvb[i];
-		for (; i<lena; i++)
-			sum[i] = fva[i];
-	}
-	return sum;
+		std::copy(fva + len, fva + lena, sum.begin() + len);
 }
 
 /// Vector (point-wise) subtraction
 /// The shorter vector is assumed to be zero-padded.
-std::vector<double> opencog::minus(const std::vector<double>& fva,
-                                   const std::vector<double>& fvb)
+void opencog::minus(std::vector<double>& diff,
+                    const double* fva, size_t lena,
+                    const double* fvb, size_t lenb)
 {
-	size_t lena = fva.size();
-	size_t lenb = fvb.size();
-
 	if (1 == lena)
-		return minus(fva[0], fvb);
+	{
+		diff.resize(lenb);
+		vec_minus(diff.data(), fva[0], fvb, lenb);
+		return;
+	}
 
 	if (1 == lenb)
-		return minus(fva, fvb[0]);
+	{
+		diff.resize(lena);
+		vec_minus(diff.data(), fva, fvb[0], lena);
+		return;
+	}
 
-	std::vector<double> diff(std::max(lena, lenb));
+	diff.resize(std::max(lena, lenb));
+	size_t len = std::min(lena, lenb);
+	vec_minus(diff.data(), fva, fvb, len);
 	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lenb; i++)
+		for (size_t i=len; i<lenb; i++)
 			diff[i] = -fvb[i];
 	}
 	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			diff[i] = fva[i] - fvb[i];
-		for (; i<lena; i++)
-			diff[i] = fva[i];
-	}
-	return diff;
+		std::copy(fva + len, fva + lena, diff.begin() + len);
 }
 
 /// Vector (point-wise) multiplication
@@ -294,87 +288,83 @@ std::vector<double> opencog::minus(const std::vector<double>& fva,
 /// is the general user intent.  We could detect this case in all
 /// the callers to this routine, or we could just handle it here.
 /// This may seem messy to you, but this is the easiest solution.
-std::vector<double> opencog::times(const std::vector<double>& fva,
-                                   const std::vector<double>& fvb)
+void opencog::times(std::vector<double>& prod,
+                    const double* fva, size_t lena,
+                    const double* fvb, size_t lenb)
 {
-	size_t lena = fva.size();
-	size_t lenb = fvb.size();
-
-	std::vector<double> prod(std::max(lena, lenb));
+	// A scalar times an empty vector is a single zero. Odd, but
+	// that is how it has always been.
+	prod.assign(std::max(lena, lenb), 0.0);
 	if (1 == lena)
-	{
-		double f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			prod[i] = f * fvb[i];
-	}
+		vec_times(prod.data(), fva[0], fvb, lenb);
 	else
 	if (1 == lenb)
-	{
-		double f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			prod[i] = f * fva[i];
-	}
+		vec_times(prod.data(), fvb[0], fva, lena);
 	else
-	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lenb; i++)
-			prod[i] = fvb[i];
+		size_t len = std::min(lena, lenb);
+		vec_times(prod.data(), fva, fvb, len);
+		if (lena < lenb)
+			std::copy(fvb + len, fvb + lenb, prod.begin() + len);
+		else
+			std::copy(fva + len, fva + lena, prod.begin() + len);
 	}
-	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			prod[i] = fva[i] * fvb[i];
-		for (; i<lena; i++)
-			prod[i] = fva[i];
-	}
-	return prod;
 }
 
 /// Vector (point-wise) division
 /// The shorter vector is assumed to be one-padded.
 /// If the shorter vector has length one, assume its a scalar.
 /// See comments on times() above about scalars.
-std::vector<double> opencog::divide(const std::vector<double>& fva,
-                                    const std::vector<double>& fvb)
+void opencog::divide(std::vector<double>& ratio,
+                     const double* fva, size_t lena,
+                     const double* fvb, size_t lenb)
 {
-	size_t lena = fva.size();
-	size_t lenb = fvb.size();
-
-	std::vector<double> ratio(std::max(lena, lenb));
+	ratio.assign(std::max(lena, lenb), 0.0);
 	if (1 == lena)
-	{
-		double f = fva[0];
-		for (size_t i=0; i<lenb; i++)
-			ratio[i] = f / fvb[i];
-	}
+		vec_divide(ratio.data(), fva[0], fvb, lenb);
 	else
 	if (1 == lenb)
-	{
-		double f = fvb[0];
-		for (size_t i=0; i<lena; i++)
-			ratio[i] = fva[i] / f;
-	}
+		vec_divide(ratio.data(), fva, fvb[0], lena);
 	else
-	if (lena < lenb)
 	{
-		size_t i=0;
-		for (; i<lena; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lenb; i++)
-			ratio[i] = 1.0 / fvb[i];
-	}
-	else
-	{
-		size_t i=0;
-		for (; i<lenb; i++)
-			ratio[i] = fva[i] / fvb[i];
-		for (; i<lena; i++)
-			ratio[i] = fva[i];
+		size_t len = std::min(lena, lenb);
+		vec_divide(ratio.data(), fva, fvb, len);
+		if (lena < lenb)
+			vec_divide(ratio.data() + len, 1.0, fvb + len, lenb - len);
+		else
+			std::copy(fva + len, fva + lena, ratio.begin() + len);
 	}
+}
+
+std::vector<double> opencog::plus(const std::vector<double>& fva,
+                                  const std::vector<double>& fvb)
+{
+	std::vector<double> sum;
+	plus(sum, fva.data(), fva.size(), fvb.data(), fvb.size());
+	return sum;
+}
+
+std::vector<double> opencog::minus(const std::vector<double>& fva,
+                                   const std::vector<double>& fvb)
+{
+	std::vector<double> diff;
+	minus(diff, fva.data(), fva.size(), fvb.data(), fvb.size());
+	return diff;
+}
+
+std::vector<double> opencog::times(const std::vector<double>& fva,
+                                   const std::vector<double>& fvb)
+{
+	std::vector<double> prod;
+	times(prod, fva.data(), fva.size(), fvb.data(), fvb.size());
+	return prod;
+}
+
+std::vector<double> opencog::divide(const std::vector<double>& fva,
+                                    const std::vector<double>& fvb)
+{
+	std::vector<double> ratio;
+	divide(ratio, fva.data(), fva.size(), fvb.data(), fvb.size());
 	return ratio;
 }
 
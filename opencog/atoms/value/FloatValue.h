@@ -41,11 +41,17 @@ class FloatValue
 	: public Value
 {
 	friend class TransposeColumn;
+	friend class Atom;            // Needs to call add_in_place()
 
 protected:
 	mutable std::vector<double> _value;
 
 	virtual void update() const {}
+
+	// Values are immutable; these are for Atom::incrementCount()
+	// only, which calls them only when no one else can see it.
+	void add_in_place(const std::vector<double>&);
+	void add_in_place(size_t, double);
 	std::string to_string(const std::string&, Type) const;
 
 	FloatValue(Type t) : Value(t) {}
@@ -113,6 +119,14 @@ std::vector<double> minus(const std::vector<double>&, const std::vector<double>&
 std::vector<double> times(const std::vector<double>&, const std::vector<double>&);
 std::vector<double> divide(const std::vector<double>&, const std::vector<double>&);
 
+/// The same, writing the result into the first argument, and reusing
+/// its storage. The inputs are given as pointer and length; they must
+/// not overlap the result.
+void plus(std::vector<double>&, const double*, size_t, const double*, size_t);
+void minus(std::vector<double>&, const double*, size_t, const double*, size_t);
+void times(std::vector<double>&, const double*, size_t, const double*, size_t);
+void divide(std::vector<double>&, const double*, size_t, const double*, size_t);
+
 /// Vector multiplication and addition. When operating on an object
 /// times itself, take a sample first; this is needed to correctly
 /// handle streaming values, as they issue new values every time
@@ -31,7 +31,7 @@ typedef concurrent_queue<ValuePtr> conq;
 // ==============================================================
 
 QueueValue::QueueValue(const ValueSeq& vseq)
-	: ContainerValue(QUEUE_VALUE)
+	: QueueValue(QUEUE_VALUE)
 {
 	for (const ValuePtr& v: vseq)
 		push(v); // concurrent_queue<ValuePtr>::push(v);
@@ -59,7 +59,11 @@ QueueValue::QueueValue(const ValueSeq& vseq)
 void QueueValue::update() const
 {
 	// Do nothing; we don't want to clobber the _value
-	if (is_closed() and 0 == conq::size()) return;
+	if (is_closed() and 0 == conq::size())
+	{
+		rethrow_error();
+		return;
+	}
 
 	// Reset, to start with.
 	_value.clear();
@@ -72,6 +76,7 @@ void QueueValue::update() const
 			ValuePtr val;
 			const_cast<QueueValue*>(this) -> pop(val);
 			_value.emplace_back(val);
+			made_room();
 		}
 	}
 	catch (typename conq::Canceled& e)
@@ -88,6 +93,71 @@ void QueueValue::update() const
 		_value.emplace_back(std::move(rem.front()));
 		rem.pop();
 	}
+	made_room();
+	rethrow_error();
+}
+
+// ==============================================================
+
+void QueueValue::set_capacity(size_t cap)
+{
+	std::lock_guard<std::mutex> lck(_room_mtx);
+	_capacity = cap;
+	_room.notify_all();
+}
+
+// Block until there is room for one more, or the queue is closed.
+// Several writers may be let through at once; the bound is not exact.
+void QueueValue::wait_for_room(void)
+{
+	if (0 == _capacity) return;
+
+	std::unique_lock<std::mutex> lck(_room_mtx);
+	auto has_room = [this]
+		{ return conq::size() < _capacity or conq::is_closed(); };
+	if (has_room()) return;
+
+	clock::time_point start = clock::now();
+	_room.wait(lck, has_room);
+	_blocked_usec += std::chrono::duration_cast<std::chrono::microseconds>(
+		clock::now() - start).count();
+}
+
+// Wake up any writers waiting in wait_for_room(). Taking the lock
+// ensures that a writer that has just found the queue full is already
+// waiting, and so will get the notification.
+void QueueValue::made_room(void) const
+{
+	if (0 == _capacity) return;
+	{ std::lock_guard<std::mutex> lck(_room_mtx); }
+	_room.notify_all();
+}
+
+void QueueValue::record_add(void)
+{
+	if (0 < _count++) return;
+	std::lock_guard<std::mutex> lck(_room_mtx);
+	_first = clock::now();
+}
+
+QueueValue::Stats QueueValue::get_stats(void) const
+{
+	typedef std::chrono::duration<double> seconds;
+
+	std::lock_guard<std::mutex> lck(_room_mtx);
+	Stats st;
+	st.count = _count;
+	st.blocked = 1.0e-6 * _blocked_usec;
+
+	clock::time_point end = conq::is_closed() ? _closed : clock::now();
+	st.elapsed = seconds(end - _opened).count();
+
+	// The first add is counted before its time is recorded.
+	if (_first < _opened)
+		st.first_latency = -1.0;
+	else
+		st.first_latency = seconds(_first - _opened).count();
+	return st;
 }
 
 // ==============================================================
@@ -95,13 +165,28 @@ void QueueValue::update() const
 void QueueValue::open()
 {
 	if (not conq::is_closed()) return;
+	{
+		std::lock_guard<std::mutex> lck(_room_mtx);
+		_count = 0;
+		_blocked_usec = 0;
+		_opened = clock::now();
+		_first = clock::time_point();
+		_error = nullptr;
+	}
 	conq::open();
 }
 
 void QueueValue::close()
 {
 	if (conq::is_closed()) return;
+	{
+		std::lock_guard<std::mutex> lck(_room_mtx);
+		_closed = clock::now();
+	}
 	conq::close();
+
+	// Writers blocked on a full queue must wake up, and find it closed.
+	made_room();
 }
 
 bool QueueValue::is_closed() const
@@ -109,16 +194,42 @@ bool QueueValue::is_closed() const
 	return conq::is_closed();
 }
 
+void QueueValue::fail(std::exception_ptr err)
+{
+	if (conq::is_closed()) return;
+	{
+		std::lock_guard<std::mutex> lck(_room_mtx);
+		_error = err;
+	}
+	close();
+}
+
+std::exception_ptr QueueValue::get_error(void) const
+{
+	std::lock_guard<std::mutex> lck(_room_mtx);
+	return _error;
+}
+
+void QueueValue::rethrow_error(void) const
+{
+	std::exception_ptr err(get_error());
+	if (err) std::rethrow_exception(err);
+}
+
 // ==============================================================
 
 void QueueValue::add(const ValuePtr& vp)
 {
+	wait_for_room();
 	conq::push(vp);
+	record_add();
 }
 
 void QueueValue::add(ValuePtr&& vp)
 {
+	wait_for_room();
 	conq::push(vp);
+	record_add();
 }
 
 ValuePtr QueueValue::remove(void)
@@ -135,19 +246,26 @@ ValuePtr QueueValue::remove(void)
 	// Use try_get first, in case the queue is closed.
 	ValuePtr vp;
 	if (conq::try_get(vp))
+	{
+		made_room();
 		return vp;
+	}
 
 	// If we are here, then the queue is empty.
 	// If it is closed, then it's end-of-stream.
 	// Else, we block and wait.
 	// If the queue closes while we are blocked, we will catch an exception.
-	// Return VoidValue as the end-of-stream marker.
+	// Return VoidValue as the end-of-stream marker, unless the
+	// producer failed; then pass on the failure.
 	try
 	{
-		return conq::value_pop();
+		vp = conq::value_pop();
+		made_room();
+		return vp;
 	}
 	catch (typename conq::Canceled& e)
 	{}
+	rethrow_error();
 	return createVoidValue();
 }
 
@@ -172,12 +290,14 @@ void QueueValue::clear()
 	if (conq::is_closed())
 	{
 		conq::wait_and_take_all();
+		made_room();
 		return;
 	}
 
 	conq::close();
 	conq::wait_and_take_all();
 	conq::open();
+	made_room();
 }
 
 // ==============================================================
@@ -23,6 +23,12 @@
 #ifndef _OPENCOG_QUEUE_VALUE_H
 #define _OPENCOG_QUEUE_VALUE_H
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
 #include <opencog/util/concurrent_queue.h>
 #include <opencog/atoms/value/ContainerValue.h>
 #include <opencog/atoms/atom_types/atom_types.h>
@@ -38,22 +44,75 @@ namespace opencog
  * QueueValues provide a thread-safe FIFO queue of Values. They are
  * meant to be used for producer-consumer APIs, where the produced
  * values are to be handled in sequential order, in a different thread.
+ *
+ * By default, the queue is unbounded. If a capacity is set, then
+ * add() blocks while the queue holds that many Values, until a reader
+ * removes some, or until the queue is closed. This is back-pressure:
+ * a producer that runs ahead of its consumer is made to wait, instead
+ * of filling RAM. Adding to a closed queue throws, as before; a reader
+ * may close the queue to tell the producer to stop.
+ *
+ * A producer that fails can close the queue with fail(), passing
+ * along the exception. Readers first get all of the Values added
+ * before the failure; after that, the exception is rethrown to them.
  */
 class QueueValue
 	: public ContainerValue, protected concurrent_queue<ValuePtr>
 {
+public:
+	/// Statistics for the stream of Values, since the last open().
+	struct Stats
+	{
+		size_t count;          // Number of Values added.
+		double first_latency;  // Seconds to the first add; -1 if none.
+		double elapsed;        // Seconds to close(), or to now, if open.
+		double blocked;        // Seconds that writers waited for room.
+
+		double throughput(void) const
+		{ return (0.0 < elapsed) ? count / elapsed : 0.0; }
+	};
+
 protected:
-	QueueValue(Type t) : ContainerValue(t) {}
+	typedef std::chrono::steady_clock clock;
+
+	std::atomic<size_t> _capacity;
+	mutable std::mutex _room_mtx;
+	mutable std::condition_variable _room;
+
+	std::atomic<size_t> _count;
+	std::atomic<size_t> _blocked_usec;
+	clock::time_point _opened;
+	clock::time_point _first;
+	clock::time_point _closed;
+	std::exception_ptr _error;
+
+	QueueValue(Type t) : ContainerValue(t), _capacity(0),
+		_count(0), _blocked_usec(0), _opened(clock::now()) {}
 	virtual void update() const;
+	void wait_for_room(void);
+	void made_room(void) const;
+	void record_add(void);
+	void rethrow_error(void) const;
 
 public:
-	QueueValue(void) : ContainerValue(QUEUE_VALUE) {}
+	QueueValue(void) : QueueValue(QUEUE_VALUE) {}
 	QueueValue(const ValueSeq&);
 	virtual ~QueueValue() {}
+
+	/// Bound the number of Values held; zero means unbounded.
+	void set_capacity(size_t);
+	size_t get_capacity(void) const { return _capacity; }
+	Stats get_stats(void) const;
+
 	virtual void open(void);
 	virtual void close(void);
 	virtual bool is_closed(void) const;
 
+	/// Close the queue, recording the reason why the producer stopped.
+	/// Does nothing if the queue is already closed.
+	void fail(std::exception_ptr);
+	std::exception_ptr get_error(void) const;
+
 	virtual void add(const ValuePtr&);
 	virtual void add(ValuePtr&&);
 	virtual ValuePtr remove(void);
@@ -0,0 +1,116 @@
+/*
+ * opencog/atoms/value/VectorKernels.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include "VectorKernels.h"
+
+using namespace opencog;
+
+// The loops below are plain C++; the compiler vectorizes them, once
+// for each of the target clones. This file is built with -O3 (see
+// CMakeLists.txt), as -O2 does not vectorize loops whose length is
+// not known ahead of time.
+#if USE_SIMD_CLONES && defined(__x86_64__) && defined(__linux__) && \
+    defined(__GNUC__) && (not defined(__clang__) || 14 <= __clang_major__)
+	#define SIMD_CLONES __attribute__((target_clones("avx512f","avx2","default")))
+#else
+	#define SIMD_CLONES
+#endif
+
+#define INLINE inline __attribute__((always_inline))
+
+// out[i] = op(a[i])
+template<typename T, typename OP>
+static INLINE void unary(T* out, const T* a, size_t n, OP op)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = op(a[i]);
+}
+
+// out[i] = op(a[i], b[i])
+template<typename T, typename OP>
+static INLINE void binary(T* out, const T* a, const T* b, size_t n, OP op)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = op(a[i], b[i]);
+}
+
+template<typename T>
+static INLINE void times_plus(T* out, const T* a, const T* b, const T* c,
+                              size_t n)
+{
+	for (size_t i = 0; i < n; i++)
+		out[i] = a[i] * b[i] + c[i];
+}
+
+template<typename T>
+static INLINE T sum(const T* a, size_t n)
+{
+	// The compiler may not re-order floating point additions, and so
+	// cannot vectorize a plain running sum. Keep one partial sum per
+	// lane of a 64-byte register, instead; those are independent.
+	constexpr size_t W = 64 / sizeof(T);
+	T acc[W] = {};
+	size_t i = 0;
+	for (; i + W <= n; i += W)
+		for (size_t k = 0; k < W; k++)
+			acc[k] += a[i+k];
+
+	T total = 0;
+	for (size_t k = 0; k < W; k++)
+		total += acc[k];
+	for (; i < n; i++)
+		total += a[i];
+	return total;
+}
+
+// ==============================================================
+
+#define BINARY(NAME, T, OP) \
+SIMD_CLONES void opencog::NAME(T* out, const T* a, const T* b, size_t n) \
+{ \
+	binary(out, a, b, n, [](T x, T y) { return x OP y; }); \
+}
+
+#define SCALAR_LEFT(NAME, T, OP) \
+SIMD_CLONES void opencog::NAME(T* out, T s, const T* a, size_t n) \
+{ \
+	unary(out, a, n, [s](T x) { return s OP x; }); \
+}
+
+#define SCALAR_RIGHT(NAME, T, OP) \
+SIMD_CLONES void opencog::NAME(T* out, const T* a, T s, size_t n) \
+{ \
+	unary(out, a, n, [s](T x) { return x OP s; }); \
+}
+
+#define KERNELS(T) \
+	BINARY(vec_plus, T, +) \
+	BINARY(vec_minus, T, -) \
+	BINARY(vec_times, T, *) \
+	BINARY(vec_divide, T, /) \
+	SCALAR_LEFT(vec_plus, T, +) \
+	SCALAR_LEFT(vec_minus, T, -) \
+	SCALAR_RIGHT(vec_minus, T, -) \
+	SCALAR_LEFT(vec_times, T, *) \
+	SCALAR_LEFT(vec_divide, T, /) \
+	SCALAR_RIGHT(vec_divide, T, /) \
+	\
+	SIMD_CLONES void opencog::vec_times_plus(T* out, const T* a, \
+	                     const T* b, const T* c, size_t n) \
+	{ \
+		times_plus(out, a, b, c, n); \
+	} \
+	\
+	SIMD_CLONES T opencog::vec_sum(const T* a, size_t n) \
+	{ \
+		return sum(a, n); \
+	}
+
+KERNELS(double)
+KERNELS(float)
+
+/* ===================== END OF FILE ===================== */
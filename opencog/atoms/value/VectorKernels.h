@@ -0,0 +1,73 @@
+/*
+ * opencog/atoms/value/VectorKernels.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Point-wise arithmetic on arrays of doubles and floats.
+ */
+
+#ifndef _OPENCOG_VECTOR_KERNELS_H
+#define _OPENCOG_VECTOR_KERNELS_H
+
+#include <cstddef>
+
+namespace opencog
+{
+
+// On x86_64 Linux, each of these is compiled several times, for
+// AVX-512, AVX2 and plain SSE2, and the best one for the CPU is picked
+// when the library is loaded (gcc function multi-versioning). Set to
+// zero to build only the plain version.
+#define USE_SIMD_CLONES 1
+
+// The output may be the same array as one of the inputs; it must not
+// otherwise overlap them. The element counts must match; padding of
+// shorter vectors is up to the caller.
+
+/// out[i] = a[i] + b[i], and so on.
+void vec_plus(double* out, const double* a, const double* b, size_t);
+void vec_minus(double* out, const double* a, const double* b, size_t);
+void vec_times(double* out, const double* a, const double* b, size_t);
+void vec_divide(double* out, const double* a, const double* b, size_t);
+
+/// out[i] = s + a[i], and so on. The scalar is on the same side as
+/// in the arithmetic expression.
+void vec_plus(double* out, double s, const double* a, size_t);
+void vec_minus(double* out, double s, const double* a, size_t);
+void vec_minus(double* out, const double* a, double s, size_t);
+void vec_times(double* out, double s, const double* a, size_t);
+void vec_divide(double* out, double s, const double* a, size_t);
+void vec_divide(double* out, const double* a, double s, size_t);
+
+/// out[i] = a[i] * b[i] + c[i], in one pass. The compiler may use
+/// fused multiply-add instructions, so the result can differ from
+/// separate multiply and add in the last bit.
+void vec_times_plus(double* out, const double* a, const double* b,
+                    const double* c, size_t);
+
+/// Sum of all elements. The partial sums are kept in vector lanes, so
+/// the order of addition is not strictly left to right.
+double vec_sum(const double* a, size_t);
+
+// The same, for single-precision floats.
+void vec_plus(float* out, const float* a, const float* b, size_t);
+void vec_minus(float* out, const float* a, const float* b, size_t);
+void vec_times(float* out, const float* a, const float* b, size_t);
+void vec_divide(float* out, const float* a, const float* b, size_t);
+
+void vec_plus(float* out, float s, const float* a, size_t);
+void vec_minus(float* out, float s, const float* a, size_t);
+void vec_minus(float* out, const float* a, float s, size_t);
+void vec_times(float* out, float s, const float* a, size_t);
+void vec_divide(float* out, float s, const float* a, size_t);
+void vec_divide(float* out, const float* a, float s, size_t);
+
+void vec_times_plus(float* out, const float* a, const float* b,
+                    const float* c, size_t);
+
+float vec_sum(const float* a, size_t);
+
+} // namespace opencog
+
+#endif // _OPENCOG_VECTOR_KERNELS_H
@@ -19,7 +19,14 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #include <stdlib.h>
 
@@ -60,6 +67,48 @@ void AtomSpace::init(void)
     addedTypeConnection =
         _nameserver.typeAddedSignal().connect(
             &AtomSpace::typeAdded, this);
+
+    link_frame();
+}
+
+/// Place this frame into the chain of frames that it sits on.
+/// Must be called whenever the `_environ` is set up.
+void AtomSpace::link_frame(void)
+{
+    _parent = nullptr;
+    _chain_root = this;
+    _jump = this;
+    _level = 0;
+    _frame_index = nullptr;
+    if (1 != _environ.size()) return;
+
+    const AtomSpace* par = _environ[0].get();
+    _parent = par;
+    _chain_root = par->_chain_root;
+    _level = par->_level + 1;
+
+    // Skew-binary jump pointers: if the parent's jump, and the jump
+    // after that, span equal distances, then leap over both of them.
+    const AtomSpace* pj = par->_jump;
+    if (par->_level - pj->_level == pj->_level - pj->_jump->_level)
+        _jump = pj->_jump;
+    else
+        _jump = par;
+
+    if (DEEP_FRAME == _level)
+        _frame_index = std::make_shared<FrameIndex>();
+    else if (DEEP_FRAME < _level)
+        _frame_index = par->_frame_index;
+}
+
+/// Return the frame at the given level, in the chain below this one.
+/// The level must not be greater than our own.
+const AtomSpace* AtomSpace::ancestor(size_t lvl) const
+{
+    const AtomSpace* as = this;
+    while (lvl < as->_level)
+        as = (lvl <= as->_jump->_level) ? as->_jump : as->_parent;
+    return as;
 }
 
 /**
@@ -71,7 +120,8 @@ AtomSpace::AtomSpace(AtomSpace* parent, bool transient) :
     _read_only(false),
     _copy_on_write(transient),
     _nameserver(nameserver()),
-    addedTypeConnection(0)
+    addedTypeConnection(0),
+    _stats(this)
 {
     if (parent) {
         // Set the COW flag by default, for any Atomspace that sits on
@@ -89,7 +139,8 @@ AtomSpace::AtomSpace(const AtomSpacePtr& parent) :
     _read_only(false),
     _copy_on_write(false),
     _nameserver(nameserver()),
-    addedTypeConnection(0)
+    addedTypeConnection(0),
+    _stats(this)
 {
     if (nullptr != parent) {
         // Set the COW flag by default; it seems like a simpler
@@ -107,7 +158,8 @@ AtomSpace::AtomSpace(const HandleSeq& bases) :
     _read_only(false),
     _copy_on_write(false),
     _nameserver(nameserver()),
-    addedTypeConnection(0)
+    addedTypeConnection(0),
+    _stats(this)
 {
     if (0 < bases.size()) _copy_on_write = true;
     init();
@@ -170,6 +222,8 @@ void AtomSpace::install(void)
              base->to_string().c_str());
     }
 
+    link_frame();
+
     // It is the _environ and not the _outgoing that has to get it's
     // incoming set set up.
     Handle llc(get_handle());
@@ -421,28 +475,26 @@ Handle AtomSpace::getOutgoingAtom(Arity n) const
 /// Search for the given AtomSpace in our stack. Return a count to
 /// the shallowest copy found. Return -1 if the AtomSpace is not found
 /// in the stack.
-// Tail-recursive implementation, should be fast.
+//
+// Within a chain of frames, this is answered by the levels, and a
+// walk along the jump pointers; only the merges need a search.
 int AtomSpace::depth(const AtomSpace* as) const
 {
     if (nullptr == as) return -1;
     if (as == this) return 0;
 
-    // As long as _environ is exactly one in size, just loop.
-    int lvl = 1;
-    const std::vector<AtomSpacePtr>* env = &_environ;
-    while (true)
+    // Frames in the same chain are either directly below us, or they
+    // are in some other branch.
+    if (as->_chain_root == _chain_root)
     {
-        size_t evs = env->size();
-        if (0 == evs) return -1;
-        if (1 < evs) break;
-        if (as == (*env)[0].get()) return lvl;
-        lvl++;
-        env = &((*env)[0]->_environ);
+        if (as->_level < _level and ancestor(as->_level) == as)
+            return _level - as->_level;
+        return -1;
     }
 
-    // Hunt for shallowest.
+    // Hunt for shallowest, in the bases of the root of the chain.
     int shallowest = -1;
-    for (const AtomSpacePtr& base : _environ)
+    for (const AtomSpacePtr& base : _chain_root->_environ)
     {
         int d = base->depth(as);
         if (0 <= d and
@@ -452,7 +504,7 @@ int AtomSpace::depth(const AtomSpace* as) const
         }
     }
     if (0 <= shallowest)
-        return lvl + shallowest;
+        return _level + 1 + shallowest;
 
     return -1;
 }
@@ -469,16 +521,10 @@ bool AtomSpace::in_environ(const AtomSpace* as) const
 {
     if (nullptr == as) return false;
     if (as == this) return true;
-    const std::vector<AtomSpacePtr>* env = &_environ;
-    while (true)
-    {
-        size_t evs = env->size();
-        if (0 == evs) return false;
-        if (1 < evs) break;
-        if (as == (*env)[0].get()) return true;
-        env = &((*env)[0]->_environ);
-    }
-    for (const AtomSpacePtr& base : *env)
+    if (as->_chain_root == _chain_root)
+        return as->_level < _level and ancestor(as->_level) == as;
+
+    for (const AtomSpacePtr& base : _chain_root->_environ)
     {
         if (base->in_environ(as)) return true;
     }
@@ -499,6 +545,113 @@ bool AtomSpace::in_environ(const Handle& atom) const
 
 // ====================================================================
 
+/// Height of an Atom: zero for Nodes, else one more than the highest
+/// Atom in the outgoing set.
+static size_t height(const Handle& h)
+{
+    if (not h->is_link()) return 0;
+    size_t ht = 0;
+    for (const Handle& ho : h->getOutgoingSet())
+        ht = std::max(ht, height(ho) + 1);
+    return ht;
+}
+
+/// Copy what is visible in the `run` of frames into this (new, empty)
+/// frame. The run is given top-most frame first. The top-most copy of
+/// each Atom is the visible one, and so that is the one copied.
+void AtomSpace::squash_into(const std::vector<const AtomSpace*>& run)
+{
+    UnorderedHandleSet seen;
+    std::vector<std::pair<size_t, Handle>> present;
+    std::vector<std::pair<size_t, Handle>> absent;
+    for (const AtomSpace* as : run)
+    {
+        HandleSeq hseq;
+        as->get_atoms_in_frame(hseq);
+        for (const Handle& h : hseq)
+        {
+            if (not seen.insert(h).second) continue;
+            if (h->isAbsent())
+                absent.push_back({height(h), h});
+            else
+                present.push_back({height(h), h});
+        }
+    }
+
+    // Lowest first, so that the outgoing sets are already here, with
+    // their Values, when the Links holding them are added. The add is
+    // forced, so that a copy is made here, even if there is another
+    // one underneath; that is what shadowing is.
+    std::sort(present.begin(), present.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    for (const auto& pr : present)
+        add(pr.second, true);
+
+    // Highest first, so that a Link is hidden while what it holds is
+    // still visible. Atoms that were added and then hidden, all within
+    // the run, have nothing to hide.
+    std::sort(absent.begin(), absent.end(),
+        [](const auto& a, const auto& b) { return a.first > b.first; });
+    for (const auto& pr : absent)
+    {
+        if (nullptr == lookupHandle(pr.second)) continue;
+        const Handle& hide(add(pr.second, true, true, true));
+        hide->setAbsent();
+    }
+    if (not absent.empty())
+        TypeIndex::changed(NOTYPE);
+}
+
+AtomSpacePtr AtomSpace::squash(const AtomSpace* bottom,
+                               const AtomSpace* top) const
+{
+    if (nullptr == bottom or nullptr == top or
+        top->_chain_root != _chain_root or
+        bottom->_chain_root != _chain_root or
+        not in_environ(top) or not top->in_environ(bottom))
+        throw RuntimeException(TRACE_INFO,
+            "AtomSpace::squash - frames must be in one chain beneath this one");
+
+    // The frames above the run, and the run, each top-most first.
+    std::vector<const AtomSpace*> above;
+    std::vector<const AtomSpace*> run;
+    const AtomSpace* as = this;
+    for (; as != top; as = as->_parent) above.push_back(as);
+    for (; as != bottom; as = as->_parent) run.push_back(as);
+    run.push_back(bottom);
+
+    // The squashed frame sits on whatever the bottom of the run did.
+    AtomSpacePtr sq;
+    size_t nbases = bottom->_environ.size();
+    if (0 == nbases)
+        sq = createAtomSpace();
+    else if (1 == nbases)
+        sq = createAtomSpace(bottom->_environ[0]);
+    else
+    {
+        HandleSeq bases;
+        for (const AtomSpacePtr& base : bottom->_environ)
+            bases.push_back(HandleCast(base));
+        sq = createAtomSpace(bases);
+        sq->install();
+    }
+    sq->_copy_on_write = top->_copy_on_write;
+    sq->squash_into(run);
+    sq->_read_only = top->_read_only;
+
+    // Replay the frames above, one at a time.
+    for (auto it = above.rbegin(); it != above.rend(); it++)
+    {
+        sq = createAtomSpace(sq);
+        sq->_copy_on_write = (*it)->_copy_on_write;
+        sq->squash_into({*it});
+        sq->_read_only = (*it)->_read_only;
+    }
+    return sq;
+}
+
+// ====================================================================
+
 Handle AtomSpace::add_atom(const Handle& h)
 {
     // Cannot add atoms to a read-only atomspace. But if it's already
@@ -547,6 +700,264 @@ ValuePtr AtomSpace::add_atoms(const ValuePtr& vptr)
     return vptr;
 }
 
+// ====================================================================
+// Bulk loading.
+
+/// Run `fn(i)` for all `i` in `[0, n)`, spread over `nthreads`
+/// threads. The first exception thrown by `fn` is rethrown here.
+static void parallel_for(size_t nthreads, size_t n,
+                         const std::function<void(size_t)>& fn)
+{
+    static constexpr size_t GRAIN = 64;
+    nthreads = std::min(nthreads, (n + GRAIN - 1) / GRAIN);
+    if (nthreads < 2)
+    {
+        for (size_t i = 0; i < n; i++) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr err;
+    std::mutex emtx;
+    auto work = [&]()
+    {
+        try
+        {
+            while (true)
+            {
+                size_t start = next.fetch_add(GRAIN);
+                if (n <= start) return;
+                size_t end = std::min(n, start + GRAIN);
+                for (size_t i = start; i < end; i++) fn(i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lck(emtx);
+            if (nullptr == err) err = std::current_exception();
+            next = n;
+        }
+    };
+
+    std::vector<std::thread> thrs;
+    for (size_t t = 1; t < nthreads; t++)
+        thrs.emplace_back(work);
+    work();
+    for (std::thread& t : thrs) t.join();
+    if (err) std::rethrow_exception(err);
+}
+
+static size_t floor_pow2(size_t n)
+{
+    size_t p = 1;
+    while (2 * p <= n) p *= 2;
+    return p;
+}
+
+// What happened to each Atom in the batch.
+enum BatchState : char
+{
+    BATCH_DONE = 0,       // Already in the AtomSpace, or failed.
+    BATCH_INSTALLED,      // Not yet in the TypeIndex; install() done.
+    BATCH_DEFERRED        // Not yet in the TypeIndex, nor incoming sets.
+};
+
+/// Everything that add_atom() does, short of the TypeIndex insert.
+/// For plain Links, the install() into the incoming sets is left for
+/// later, too; StateLinks and TriggerLinks do special things then,
+/// and so are installed right away.
+Handle AtomSpace::batch_prepare(const Handle& orig, char& state)
+{
+    state = BATCH_DONE;
+    try {
+        bool fresh;
+        Handle atom(prepare_add(orig, false, false, false, fresh));
+        if (not fresh) return atom;
+
+        atom->setAtomSpace(this);
+        atom->keep_incoming_set();
+
+        Type t = atom->get_type();
+        if (atom->is_link() and not _nameserver.isA(t, STATE_LINK)
+            and not _nameserver.isA(t, TRIGGER_LINK))
+        {
+            state = BATCH_DEFERRED;
+            return atom;
+        }
+        atom->install();
+        state = BATCH_INSTALLED;
+        return atom;
+    }
+    catch (const DeleteException& ex) { /* Do nothing */ }
+    catch (const ValueReturnException& ex) {
+        throw;
+    }
+    catch (const SilentException& ex) {
+        return lookupHide(orig, false);
+    }
+    return Handle::UNDEFINED;
+}
+
+HandleSeq AtomSpace::add_atoms_batch(const HandleSeq& hseq, size_t nthreads)
+{
+    if (0 == nthreads)
+        nthreads = std::max(1U, std::thread::hardware_concurrency());
+
+    // Frames have all sorts of special cases for hiding and shadowing
+    // Atoms in the frames below. Don't try to be clever with those.
+    if (_read_only or _copy_on_write or 0 < _environ.size() or
+        nthreads < 2)
+    {
+        HandleSeq result;
+        result.reserve(hseq.size());
+        for (const Handle& h : hseq)
+            result.emplace_back(add_atom(h));
+        return result;
+    }
+
+    // Work through the batch a window at a time, so that the
+    // bookkeeping stays small.
+    static constexpr size_t WINDOW = 1 << 18;
+    HandleSeq result(hseq.size());
+    for (size_t start = 0; start < hseq.size(); start += WINDOW)
+        add_batch_window(hseq, result, start,
+                         std::min(hseq.size(), start + WINDOW), nthreads);
+    return result;
+}
+
+void AtomSpace::add_batch_window(const HandleSeq& hseq, HandleSeq& result,
+                                 size_t begin, size_t end, size_t nthreads)
+{
+    // Sort the window into levels. Level zero holds the Nodes, and
+    // the Links that hold nothing else from this window. Each Link is
+    // one level above the highest of what it holds. Thus, everything
+    // in a level can be added at the same time.
+    std::unordered_map<const Atom*, std::pair<size_t, size_t>> seen;
+    std::vector<std::vector<size_t>> levels;
+    std::vector<std::pair<size_t, size_t>> repeats;
+    for (size_t i = begin; i < end; i++)
+    {
+        const Atom* a = hseq[i].operator->();
+        auto it = seen.find(a);
+        if (seen.end() != it)
+        {
+            repeats.push_back({i, it->second.second});
+            continue;
+        }
+        size_t lvl = 0;
+        if (a and a->is_link())
+        {
+            for (const Handle& ho : a->getOutgoingSet())
+            {
+                auto ot = seen.find(ho.operator->());
+                if (seen.end() != ot)
+                    lvl = std::max(lvl, ot->second.first + 1);
+            }
+        }
+        seen.insert({a, {lvl, i}});
+        if (levels.size() <= lvl) levels.resize(lvl+1);
+        levels[lvl].push_back(i);
+    }
+
+    size_t nparts = floor_pow2(nthreads);
+    for (const std::vector<size_t>& lv : levels)
+    {
+        size_t n = lv.size();
+
+        // First pass: find what is already here; make what is not.
+        std::vector<char> state(n);
+        parallel_for(nthreads, n, [&](size_t k)
+        {
+            result[lv[k]] = batch_prepare(hseq[lv[k]], state[k]);
+        });
+
+        std::vector<size_t> fresh;
+        for (size_t k = 0; k < n; k++)
+            if (BATCH_DONE != state[k]) fresh.push_back(k);
+
+        // Second pass: insert into the TypeIndex, with each thread
+        // taking a disjoint set of shards.
+        std::vector<HandleSeq> olds(nparts);
+        std::vector<std::vector<size_t>> which(nparts);
+        parallel_for(nparts, nparts, [&](size_t p)
+        {
+            HandleSeq atoms;
+            for (size_t k : fresh)
+            {
+                const Handle& h(result[lv[k]]);
+                if (TypeIndex::shard_part(h, nparts) != p) continue;
+                atoms.push_back(h);
+                which[p].push_back(k);
+            }
+            typeIndex.insertAtoms(atoms, olds[p]);
+        });
+
+        // Lost the race (to another thread, or to a copy of the same
+        // Atom in this batch). Undo, just as add() does.
+        for (size_t p = 0; p < nparts; p++)
+        {
+            for (size_t j = 0; j < which[p].size(); j++)
+            {
+                const Handle& oldh(olds[p][j]);
+                if (nullptr == oldh) continue;
+                size_t k = which[p][j];
+                Handle& atom(result[lv[k]]);
+                atom->setAtomSpace(nullptr);
+                if (BATCH_INSTALLED == state[k]) atom->remove();
+                state[k] = BATCH_DONE;
+                if (oldh != hseq[lv[k]])
+                    oldh->copyValues(hseq[lv[k]]);
+                atom = oldh;
+            }
+        }
+
+        if (not positionIndex.empty())
+        {
+            for (size_t k : fresh)
+            {
+                const Handle& h(result[lv[k]]);
+                if (BATCH_DONE != state[k] and h->is_link())
+                    positionIndex.insert(h);
+            }
+        }
+
+        // Third pass: the incoming sets. Each thread takes the Atoms
+        // guarded by a disjoint set of locks in the Atom mutex pool,
+        // so that the threads don't fight over the locks.
+        size_t nmtx = std::min(nparts, Atom::MutexPool::POOL_SIZE);
+        parallel_for(nmtx, nmtx, [&](size_t p)
+        {
+            std::vector<std::pair<Atom*, Atom*>> wires;
+            for (size_t k : fresh)
+            {
+                if (BATCH_DEFERRED != state[k]) continue;
+                const Handle& h(result[lv[k]]);
+                for (const Handle& ho : h->getOutgoingSet())
+                    if ((ho->get_hash() % Atom::MutexPool::POOL_SIZE) % nmtx == p)
+                        wires.push_back({ho.operator->(), h.operator->()});
+            }
+            std::sort(wires.begin(), wires.end());
+
+            HandleSeq links;
+            for (size_t i = 0; i < wires.size(); )
+            {
+                Atom* target = wires[i].first;
+                links.clear();
+                for (; i < wires.size() and wires[i].first == target; i++)
+                    links.emplace_back(wires[i].second->get_handle());
+                target->insert_atoms(links);
+            }
+        });
+    }
+
+    for (const auto& pr : repeats)
+    {
+        result[pr.first] = result[pr.second];
+        if (result[pr.first] and result[pr.first] != hseq[pr.first])
+            result[pr.first]->copyValues(hseq[pr.first]);
+    }
+}
+
 // COW == Copy On Write
 #define COWBOY_CODE(DO_STUFF)                                            \
     AtomSpace* has = h->getAtomSpace();                                  \
@@ -28,7 +28,10 @@
 #include <opencog/atoms/base/Node.h>
 #include <opencog/atoms/base/Link.h>
 
+#include <opencog/atomspace/AtomStats.h>
 #include <opencog/atomspace/Frame.h>
+#include <opencog/atomspace/FrameIndex.h>
+#include <opencog/atomspace/PositionIndex.h>
 #include <opencog/atomspace/TypeIndex.h>
 
 class AtomTableUTest;
@@ -50,6 +53,7 @@ typedef std::shared_ptr<AtomSpace> AtomSpacePtr;
 class AtomSpace : public Frame
 {
     friend class StorageNode;     // Needs to call add() directly.
+    friend class FrameIndex;      // Needs ancestor() and _level.
     template< class... Args >
     friend AtomSpacePtr createAtomSpace(Args&&...); // Needs to call install()
 
@@ -83,6 +87,26 @@ class AtomSpace : public Frame
     virtual void install(void) override;
     virtual void remove(void) override;
 
+    // Bookkeeping for deep stacks of frames. A run of frames, each
+    // with exactly one base, forms a chain; the chain starts at a
+    // root frame, having zero, or more than one, bases. Frames are
+    // numbered by `_level`, the distance to the root. The `_jump`
+    // pointers skip ahead, by skew-binary distances, so that finding
+    // the ancestor at a given level takes O(log n) steps and not n.
+    // The parents are held by `_environ`; plain pointers suffice.
+    const AtomSpace* _parent;
+    const AtomSpace* _chain_root;
+    const AtomSpace* _jump;
+    size_t _level;
+
+    // Frames at or above this level share a FrameIndex, so that
+    // lookups take one probe, and not one per frame.
+    static constexpr size_t DEEP_FRAME = 8;
+    std::shared_ptr<FrameIndex> _frame_index;
+
+    void link_frame(void);
+    const AtomSpace* ancestor(size_t) const;
+
     void init();
     void clear_all_atoms();
 
@@ -105,11 +129,17 @@ private:
     //! Index of atoms.
     TypeIndex typeIndex;
 
+    //! Optional index of Links, by position. See PositionIndex.h
+    PositionIndex positionIndex;
+
     /** Find out about atom type additions in the NameServer. */
     NameServer& _nameserver;
     int addedTypeConnection;
     void typeAdded(Type);
 
+    /** Statistics for query planning, computed on demand. */
+    AtomStats _stats;
+
     /**
      * Private: add an atom to the table. This skips the read-only
      * check.
@@ -125,6 +155,11 @@ private:
      */
     Handle add(const Handle&, bool force=false,
                bool recurse=false, bool absent = false);
+    Handle prepare_add(const Handle&, bool force, bool recurse,
+                       bool absent, bool& fresh);
+    Handle batch_prepare(const Handle&, char&);
+    void add_batch_window(const HandleSeq&, HandleSeq&,
+                          size_t, size_t, size_t);
     Handle check(const Handle&, bool force=false);
     Handle lookupHide(const Handle&, bool hide=false) const;
 
@@ -140,6 +175,8 @@ private:
     void get_absent_atoms(HandleSeq&) const;
     void get_atoms_in_frame(HandleSeq&) const;
 
+    void squash_into(const std::vector<const AtomSpace*>&);
+
 public:
     /**
      * Constructor and destructor for this class.
@@ -204,6 +241,30 @@ public:
     bool in_environ(const Handle&) const;
     bool in_environ(const AtomSpace*) const;
 
+    /**
+     * Squash a run of frames into one, in the manner of squashing
+     * commits in git. The run starts at `bottom`, and ends at `top`;
+     * both must be in the stack beneath this AtomSpace (or be this
+     * AtomSpace), with `bottom` at or beneath `top`.
+     *
+     * A new stack is returned. The frames beneath `bottom` are shared
+     * with the old stack. The run is replaced by a single new frame,
+     * holding what `top` sees of the run: the shallowest copy of each
+     * Atom, with its Values, and also the absent Atoms, wherever they
+     * hide something underneath. The frames above `top`, up to and
+     * including this one, are copied, one by one, on top of that.
+     * Each of these frames thus sees exactly what it saw before.
+     *
+     * The old stack is not altered, and remains valid: readers of
+     * it, and of the frames beneath it, can carry on while the
+     * squash runs. Frames in the run, and above it, should not be
+     * changed while it runs. The RAM is given back when the old
+     * stack is dropped.
+     *
+     * Returns the new copy of this AtomSpace.
+     */
+    AtomSpacePtr squash(const AtomSpace* bottom, const AtomSpace* top) const;
+
     /* AtomSpaces are Atoms; provide virtual methods of base class. */
     virtual const std::string& get_name() const;
     virtual size_t size() const { return _environ.size(); }
@@ -241,6 +302,57 @@ public:
     size_t get_size() const;
     size_t get_num_atoms_of_type(Type type, bool subclass=false) const;
 
+    /**
+     * A cheap estimate of the number of atoms of the given type.
+     * Unlike `get_num_atoms_of_type()`, this does not look for atoms
+     * that are hidden or repeated in layered (copy-on-write) spaces,
+     * and so never has to walk over the atoms themselves. For use in
+     * query planning.
+     */
+    size_t estimate_num_atoms_of_type(Type type, bool subclass=false) const;
+
+    /**
+     * Append up to `n` atoms of the given type (not subclasses) to
+     * `hseq`, taken more-or-less at random, from this space first,
+     * and then the ones below it. For gathering statistics.
+     */
+    void sample_atoms_of_type(HandleSeq& hseq, Type type, size_t n) const;
+
+    /**
+     * Statistics about the contents of this space, for use by the
+     * query planner. See AtomStats.h for details.
+     */
+    const AtomStats& get_stats() const { return _stats; }
+
+    /**
+     * Index the Links of type `t` (not subtypes) by the Atoms they
+     * hold, and the position they hold them at. This speeds up the
+     * search for Links holding some given Atom at some given place,
+     * when that Atom has a huge incoming set. It costs RAM; see
+     * `get_position_index_bytes()`. The index is maintained as Atoms
+     * are added and extracted.
+     *
+     * Only the Links in this AtomSpace are indexed. Lookups with
+     * `get_incoming_by_position()` work only if every AtomSpace in
+     * the environment indexes that type.
+     */
+    void index_positions(Type t);
+    void unindex_positions(Type t);
+    bool is_position_indexed(Type t) const;
+    size_t get_position_index_bytes() const { return positionIndex.bytes(); }
+
+    /**
+     * Append to `hseq` the Links of type `t`, visible from this
+     * AtomSpace, that hold `target` at position `pos`. An `arity` of
+     * zero matches Links of any arity. Returns false, doing nothing,
+     * if the position index can't be used: if some AtomSpace in the
+     * environment does not index type `t`, or if this space is
+     * copy-on-write. The caller then has to fall back to the
+     * incoming set.
+     */
+    bool get_incoming_by_position(HandleSeq& hseq, const Handle& target,
+                                  Type t, Arity pos, Arity arity=0) const;
+
     //! Clear the atomspace, extract all atoms.
     void clear();
 
@@ -358,6 +470,27 @@ public:
 	    return add_link(t, {ha, hb, hc, hd, he, hf, hg, hh, hi});
     }
 
+    /**
+     * Add many Atoms at once, using `nthreads` threads (zero means
+     * one per core). Returns what `add_atom()` would have returned for
+     * each of them, in the same order. Intended for bulk loading.
+     *
+     * The Atoms should be in topological order: the Atoms in the
+     * outgoing set of a Link should come before the Link, if they are
+     * in the batch at all. Lookups, and insertion into the type index,
+     * are done in parallel; Links are added to the incoming sets of
+     * their outgoing Atoms in a second pass, grouped by outgoing Atom.
+     * Until that pass finishes, other threads might see a Link that
+     * is not yet in the incoming set of the Atoms it holds.
+     *
+     * If the batch holds several different copies of the same Atom,
+     * their Values are merged in no particular order.
+     *
+     * AtomSpaces stacked on top of others, and read-only AtomSpaces,
+     * just call `add_atom()` on each Atom, in turn.
+     */
+    HandleSeq add_atoms_batch(const HandleSeq&, size_t nthreads = 0);
+
     /**
      * Given a Value, find all of the Atoms inside of it, and add them
      * to the AtomSpace. Return an equivalent Value, with all Atoms
@@ -0,0 +1,165 @@
+/*
+ * opencog/atomspace/AtomStats.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Statistics about the contents of an AtomSpace, for query planning.
+ */
+
+#include <algorithm>
+#include <sstream>
+
+#include <opencog/atoms/atom_types/NameServer.h>
+
+#include "AtomSpace.h"
+#include "AtomStats.h"
+
+using namespace opencog;
+
+// Links with very large outgoing sets are typically lists of data;
+// their later positions are not worth keeping track of.
+#define MAX_POSITIONS 16
+
+AtomStats::AtomStats(const AtomSpace* as) :
+	_as(as)
+{
+}
+
+void AtomStats::clear(void)
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	_positions.clear();
+	_incoming.clear();
+}
+
+/// A histogram is recomputed after the number of Atoms of its type
+/// has changed by more than a quarter. The slack keeps histograms of
+/// rare types from being recomputed all the time.
+bool AtomStats::stale(size_t then, size_t now)
+{
+	size_t diff = (then < now) ? now - then : then - now;
+	return then / 4 + 8 < diff;
+}
+
+size_t AtomStats::count(Type t, bool subclass) const
+{
+	return _as->estimate_num_atoms_of_type(t, subclass);
+}
+
+/// Caller must hold the lock.
+const AtomStats::Positions& AtomStats::positions(Type link) const
+{
+	size_t now = count(link);
+	auto it = _positions.find(link);
+	if (_positions.end() != it and not stale(it->second.count, now))
+		return it->second;
+
+	Positions& pos = _positions[link];
+	pos = Positions();
+	pos.count = now;
+
+	HandleSeq sample;
+	_as->sample_atoms_of_type(sample, link, SAMPLE_SIZE);
+	for (const Handle& h : sample)
+	{
+		if (not h->is_link()) continue;
+		pos.sampled++;
+		const HandleSeq& oset = h->getOutgoingSet();
+		size_t arity = std::min(oset.size(), (size_t) MAX_POSITIONS);
+		if (pos.types.size() < arity) pos.types.resize(arity);
+		for (size_t i = 0; i < arity; i++)
+			pos.types[i][oset[i]->get_type()]++;
+	}
+	return pos;
+}
+
+double AtomStats::share(Type link, size_t pos, Type target) const
+{
+	// Nothing is known about the far end of long Links.
+	if (MAX_POSITIONS <= pos) return 1.0;
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	const Positions& p = positions(link);
+	if (0 == p.sampled or p.types.size() <= pos) return 0.0;
+
+	NameServer& ns = nameserver();
+	size_t hits = 0;
+	for (const auto& pr : p.types[pos])
+		if (ns.isA(pr.first, target)) hits += pr.second;
+	return ((double) hits) / ((double) p.sampled);
+}
+
+double AtomStats::fanout(Type link, size_t pos, Type target) const
+{
+	double links = share(link, pos, target) * count(link);
+	size_t targets = count(target, true);
+	if (0 == targets) return 0.0;
+	return links / targets;
+}
+
+AtomStats::Incoming AtomStats::incoming(Type atom, Type link) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	size_t now = count(atom);
+	InEntry& ent = _incoming[{atom, link}];
+	if (0 < ent.inc.sampled and not stale(ent.count, now))
+		return ent.inc;
+
+	ent = InEntry();
+	ent.count = now;
+
+	HandleSeq sample;
+	_as->sample_atoms_of_type(sample, atom, SAMPLE_SIZE);
+	if (sample.empty()) return ent.inc;
+
+	std::vector<size_t> sizes;
+	sizes.reserve(sample.size());
+	double total = 0.0;
+	for (const Handle& h : sample)
+	{
+		sizes.push_back(h->getIncomingSetSizeByType(link));
+		total += sizes.back();
+	}
+	std::sort(sizes.begin(), sizes.end());
+
+	Incoming& inc = ent.inc;
+	inc.sampled = sizes.size();
+	inc.mean = total / sizes.size();
+	inc.median = sizes[sizes.size() / 2];
+	inc.p90 = sizes[(9 * sizes.size()) / 10];
+	inc.max = sizes.back();
+	return inc;
+}
+
+std::string AtomStats::to_string(const std::string& indent) const
+{
+	std::lock_guard<std::mutex> lck(_mtx);
+	NameServer& ns = nameserver();
+	std::stringstream ss;
+	for (const auto& pr : _positions)
+	{
+		const Positions& p = pr.second;
+		ss << indent << ns.getTypeName(pr.first)
+		   << ": " << p.count << " links, " << p.sampled << " sampled\n";
+		for (size_t i = 0; i < p.types.size(); i++)
+		{
+			ss << indent << "   [" << i << "]";
+			for (const auto& tc : p.types[i])
+				ss << " " << ns.getTypeName(tc.first) << "=" << tc.second;
+			ss << "\n";
+		}
+	}
+	for (const auto& pr : _incoming)
+	{
+		const Incoming& inc = pr.second.inc;
+		ss << indent << ns.getTypeName(pr.first.first)
+		   << " <- " << ns.getTypeName(pr.first.second)
+		   << ": " << inc.sampled << " sampled, mean " << inc.mean
+		   << ", median " << inc.median << ", p90 " << inc.p90
+		   << ", max " << inc.max << "\n";
+	}
+	return ss.str();
+}
+
+/* ===================== END OF FILE ===================== */
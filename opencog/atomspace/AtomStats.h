@@ -0,0 +1,114 @@
+/*
+ * opencog/atomspace/AtomStats.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Statistics about the contents of an AtomSpace, for query planning.
+ */
+
+#ifndef _OPENCOG_ATOM_STATS_H
+#define _OPENCOG_ATOM_STATS_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <opencog/util/empty_string.h>
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * Lightweight statistics about the contents of an AtomSpace, used by
+ * the pattern matcher to pick a place to start the search. There are
+ * three kinds:
+ *
+ * -- The number of Atoms of each type. These are cheap estimates;
+ *    see `AtomSpace::estimate_num_atoms_of_type()`.
+ *
+ * -- For each Link type, and each position in the outgoing set, a
+ *    histogram of the types of the Atoms found there.
+ *
+ * -- For each Atom type, and each Link type, the distribution of the
+ *    number of Links of that type in the incoming set.
+ *
+ * Nothing is done when Atoms are added or removed; the AtomSpace
+ * insert path is not slowed down at all. Instead, the histograms are
+ * computed on demand, from a small sample of the Atoms of the type in
+ * question, and remembered until the number of Atoms of that type has
+ * changed by more than a quarter.
+ */
+class AtomStats
+{
+public:
+	/// How many Atoms to look at, for each histogram.
+	static constexpr size_t SAMPLE_SIZE = 256;
+
+	/// Distribution of incoming-set sizes over a sample of Atoms.
+	struct Incoming
+	{
+		size_t sampled = 0;
+		double mean = 0.0;
+		size_t median = 0;
+		size_t p90 = 0;
+		size_t max = 0;
+	};
+
+	AtomStats(const AtomSpace*);
+
+	/// Estimated number of Atoms of type `t`.
+	size_t count(Type t, bool subclass=false) const;
+
+	/// Estimated fraction of the Links of type `link` that have an
+	/// Atom of type `target` (or a subtype of it) at position `pos`.
+	double share(Type link, size_t pos, Type target) const;
+
+	/// Estimated number of Links of type `link` that have any one
+	/// given Atom of type `target` at position `pos`.
+	double fanout(Type link, size_t pos, Type target) const;
+
+	/// Distribution of the number of Links of type `link` in the
+	/// incoming sets of Atoms of type `atom`.
+	Incoming incoming(Type atom, Type link) const;
+
+	/// Forget everything; it will be recomputed, as needed.
+	void clear(void);
+
+	std::string to_string(const std::string& indent=empty_string) const;
+
+private:
+	const AtomSpace* _as;
+	mutable std::mutex _mtx;
+
+	// The outgoing-set histogram, for one Link type.
+	struct Positions
+	{
+		size_t count = 0;      // Number of Links, when sampled.
+		size_t sampled = 0;
+		std::vector<std::map<Type, size_t>> types;
+	};
+	mutable std::map<Type, Positions> _positions;
+
+	struct InEntry
+	{
+		size_t count = 0;      // Number of Atoms, when sampled.
+		Incoming inc;
+	};
+	mutable std::map<std::pair<Type, Type>, InEntry> _incoming;
+
+	static bool stale(size_t then, size_t now);
+	const Positions& positions(Type) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_ATOM_STATS_H
@@ -33,6 +33,7 @@
 #include <opencog/util/Logger.h>
 #include <opencog/util/oc_assert.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cstdio>
 #include <ctime>
@@ -49,6 +50,14 @@ void AtomSpace::clear_all_atoms()
 #if USE_INCOME_INDEX
     incomeIndex.clear();
 #endif
+    if (_frame_index)
+    {
+        HandleSeq hseq;
+        typeIndex.get_handles_by_type(hseq, ATOM, true);
+        for (const Handle& h : hseq)
+            _frame_index->remove(this, h);
+    }
+    positionIndex.clear();
     typeIndex.clear();
 }
 
@@ -74,6 +83,18 @@ Handle AtomSpace::lookupHide(const Handle& a, bool hide) const
         return h;
     }
 
+    // Deep in a stack of frames, the shared index knows about all of
+    // the deep frames; only the shallow frames need to be searched.
+    if (_frame_index)
+    {
+        Handle h(_frame_index->find(a, this));
+        if (h) {
+            if (hide and h->isAbsent()) return Handle::UNDEFINED;
+            return h;
+        }
+        return ancestor(DEEP_FRAME-1)->lookupHide(a, hide);
+    }
+
     // The complicated-looking while-loop is just implementing
     // a non-recursive version of what would otherwise be a
     // much simpler recursive call back to ourselves. There's
@@ -172,9 +193,15 @@ Handle AtomSpace::check(const Handle& orig, bool force)
     return cand;
 }
 
-Handle AtomSpace::add(const Handle& orig, bool force,
-                      bool recurse, bool absent)
+/// The first half of add(): return the Atom, if we already have it.
+/// If not, return the Atom that should be inserted, and set `fresh`.
+/// This is the Atom that was handed in, or a copy of it, if it belongs
+/// to some other AtomSpace, or holds Atoms that do.
+Handle AtomSpace::prepare_add(const Handle& orig, bool force,
+                              bool recurse, bool absent, bool& fresh)
 {
+    fresh = false;
+
     // Can be null, if its a Value
     if (nullptr == orig) return Handle::UNDEFINED;
 
@@ -280,6 +307,17 @@ Handle AtomSpace::add(const Handle& orig, bool force,
     if (atom != orig)
         atom->copyValues(orig);
 
+    fresh = true;
+    return atom;
+}
+
+Handle AtomSpace::add(const Handle& orig, bool force,
+                      bool recurse, bool absent)
+{
+    bool fresh;
+    Handle atom(prepare_add(orig, force, recurse, absent, fresh));
+    if (not fresh) return atom;
+
     // Must set atomspace before insertion. This must be done before the
     // atom becomes visible at the typeIndex insert.  Likewise for setting
     // up the incoming set.
@@ -294,12 +332,20 @@ Handle AtomSpace::add(const Handle& orig, bool force,
     // as the atom is being deleted.
     atom->install();
 
+    // Same as above: a thread that found this atom in the typeIndex
+    // might extract it, and expects to find it in the position index.
+    if (not positionIndex.empty() and atom->is_link())
+        positionIndex.insert(atom);
+
     // Between the time that we last checked, and here, some other thread
     // may have raced and inserted this atom already. So the insert does
     // have to be an atomic test-n-set.
     const Handle& oldh(typeIndex.insertAtom(atom));
     if (oldh)
     {
+        if (not positionIndex.empty() and atom->is_link())
+            positionIndex.remove(atom);
+
 #if USE_INCOME_INDEX
         // Due to racing with other threads, this Atom might not
         // only be in the AtomSpace already, but it might even have
@@ -314,6 +360,7 @@ Handle AtomSpace::add(const Handle& orig, bool force,
         atom->remove();
         return oldh;
     }
+    if (_frame_index) _frame_index->insert(this, _level, atom);
     return atom;
 }
 
@@ -344,6 +391,85 @@ size_t AtomSpace::get_num_atoms_of_type(Type type, bool subclass) const
     return result;
 }
 
+size_t AtomSpace::estimate_num_atoms_of_type(Type type, bool subclass) const
+{
+    size_t result = typeIndex.size(type, subclass);
+    for (const AtomSpacePtr& base : _environ)
+        result += base->estimate_num_atoms_of_type(type, subclass);
+    return result;
+}
+
+void AtomSpace::sample_atoms_of_type(HandleSeq& hseq, Type type,
+                                     size_t n) const
+{
+    size_t start = hseq.size();
+    typeIndex.sample(hseq, type, n);
+    for (const AtomSpacePtr& base : _environ)
+    {
+        size_t got = hseq.size() - start;
+        if (n <= got) break;
+        base->sample_atoms_of_type(hseq, type, n - got);
+    }
+}
+
+void AtomSpace::index_positions(Type t)
+{
+    if (not _nameserver.isLink(t))
+        throw InvalidParamException(TRACE_INFO,
+            "Only Links can be indexed by position, got %s",
+            _nameserver.getTypeName(t).c_str());
+
+    if (not positionIndex.enable(t)) return;
+
+    // Index what is here already. Links extracted while this runs
+    // might be put back into the index after having been removed
+    // from it; check for that, after the fact.
+    HandleSeq hseq;
+    typeIndex.get_handles_by_type(hseq, t, false);
+    for (const Handle& h : hseq)
+    {
+        positionIndex.insert(h);
+        if (typeIndex.findAtom(h) != h)
+            positionIndex.remove(h);
+    }
+}
+
+void AtomSpace::unindex_positions(Type t)
+{
+    positionIndex.disable(t);
+}
+
+bool AtomSpace::is_position_indexed(Type t) const
+{
+    return positionIndex.is_enabled(t);
+}
+
+bool AtomSpace::get_incoming_by_position(HandleSeq& hseq,
+                                         const Handle& target,
+                                         Type t, Arity pos,
+                                         Arity arity) const
+{
+    // Copy-on-write spaces hide and shadow Atoms in the spaces below;
+    // sorting that out is more than an index can do.
+    if (_copy_on_write) return false;
+
+    // Check first, so that nothing is appended if we can't finish.
+    std::vector<const AtomSpace*> spaces({this});
+    for (size_t i = 0; i < spaces.size(); i++)
+    {
+        const AtomSpace* as = spaces[i];
+        if (not as->positionIndex.is_enabled(t)) return false;
+        for (const AtomSpacePtr& base : as->_environ)
+            if (spaces.end() == std::find(spaces.begin(), spaces.end(),
+                                          base.get()))
+                spaces.push_back(base.get());
+    }
+
+    for (const AtomSpace* as : spaces)
+        as->positionIndex.get(hseq, t, target, pos, arity);
+    return true;
+}
+
 bool AtomSpace::extract_atom(const Handle& h, bool recursive)
 {
     if (nullptr == h) return false;
@@ -407,6 +533,7 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
         // If we are here, then mask.
         const Handle& hide(add(handle, true, true, true));
         hide->setAbsent();
+        TypeIndex::changed(NOTYPE);
         return true;
     }
 
@@ -428,6 +555,7 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
         if (_copy_on_write) {
             const Handle& hide(add(handle, true, true, true));
             hide->setAbsent();
+            TypeIndex::changed(NOTYPE);
             return true;
         }
 
@@ -446,6 +574,7 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
             {
                 const Handle& hide(add(handle, true, true, true));
                 hide->setAbsent();
+                TypeIndex::changed(NOTYPE);
                 return true;
             }
         }
@@ -478,6 +607,10 @@ bool AtomSpace::extract_atom(const Handle& h, bool recursive)
         return false;
     }
 
+    if (not positionIndex.empty() and handle->is_link())
+        positionIndex.remove(handle);
+    if (_frame_index) _frame_index->remove(this, handle);
+
     // Remove handle from other incoming sets.
     handle->remove();
     handle->drop_incoming_set();
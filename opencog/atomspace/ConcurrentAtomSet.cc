@@ -0,0 +1,321 @@
+/*
+ * opencog/atomspace/ConcurrentAtomSet.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Hash set of Atoms with lock-free lookup, for the TypeIndex.
+ */
+
+#include <thread>
+
+#include "ConcurrentAtomSet.h"
+
+using namespace opencog;
+
+// ================================================================
+// Epoch-based reclamation.
+//
+// Each thread that has ever done a lock-free lookup owns a record on
+// a global, grow-only list. An active reader publishes the global
+// epoch that it saw on entry; an idle reader publishes zero. Records
+// are recycled when threads exit, but are never freed.
+
+namespace {
+
+struct alignas(64) EpochRecord
+{
+	std::atomic<uint64_t> epoch{0};
+	std::atomic<bool> in_use{true};
+	EpochRecord* next = nullptr;
+	int depth = 0;  // Nesting; touched by the owning thread only.
+};
+
+std::atomic<uint64_t> _global_epoch{1};
+std::atomic<EpochRecord*> _records{nullptr};
+
+EpochRecord* acquire_record(void)
+{
+	for (EpochRecord* r = _records.load(); r; r = r->next)
+	{
+		bool idle = false;
+		if (r->in_use.compare_exchange_strong(idle, true))
+			return r;
+	}
+
+	EpochRecord* r = new EpochRecord();
+	r->next = _records.load();
+	while (not _records.compare_exchange_weak(r->next, r)) {}
+	return r;
+}
+
+// Give the record back when the thread exits.
+struct RecordHolder
+{
+	EpochRecord* rec;
+	RecordHolder(void) : rec(acquire_record()) {}
+	~RecordHolder() { rec->in_use.store(false); }
+};
+
+EpochRecord* my_record(void)
+{
+	static thread_local RecordHolder holder;
+	return holder.rec;
+}
+
+} // anonymous namespace
+
+EpochGuard::EpochGuard(void)
+{
+	EpochRecord* r = my_record();
+	_rec = r;
+	if (0 < r->depth++) return;
+
+	// The store must be visible before any of the loads that follow;
+	// seq_cst provides the needed store-load ordering.
+	r->epoch.store(_global_epoch.load());
+}
+
+EpochGuard::~EpochGuard()
+{
+	EpochRecord* r = (EpochRecord*) _rec;
+	if (0 < --r->depth) return;
+	r->epoch.store(0, std::memory_order_release);
+}
+
+/// Start a new epoch. Return the old one; anything unlinked before
+/// this call can be freed once `epoch_min_active()` exceeds it.
+uint64_t opencog::epoch_advance(void)
+{
+	return _global_epoch.fetch_add(1);
+}
+
+/// The oldest epoch still in use by some reader.
+uint64_t opencog::epoch_min_active(void)
+{
+	uint64_t emin = _global_epoch.load();
+	for (EpochRecord* r = _records.load(); r; r = r->next)
+	{
+		uint64_t e = r->epoch.load();
+		if (0 != e and e < emin) emin = e;
+	}
+	return emin;
+}
+
+/// Wait until all readers that are currently active have finished.
+void opencog::epoch_synchronize(void)
+{
+	uint64_t stamp = epoch_advance();
+	while (epoch_min_active() <= stamp)
+		std::this_thread::yield();
+}
+
+// ================================================================
+
+ConcurrentAtomSet::Table::Table(size_t cap) :
+	mask(cap - 1),
+	slots(new std::atomic<Atom*>[cap]),
+	owners(new Handle[cap])
+{
+	for (size_t i = 0; i < cap; i++)
+		slots[i].store(nullptr, std::memory_order_relaxed);
+}
+
+ConcurrentAtomSet::ConcurrentAtomSet(void) :
+	_table(nullptr),
+	_size(0),
+	_used(0)
+{
+}
+
+ConcurrentAtomSet::ConcurrentAtomSet(ConcurrentAtomSet&& other) noexcept :
+	_table(other._table.exchange(nullptr)),
+	_size(other._size),
+	_used(other._used),
+	_retired(std::move(other._retired))
+{
+	other._size = 0;
+	other._used = 0;
+	other._retired.clear();
+}
+
+ConcurrentAtomSet::~ConcurrentAtomSet()
+{
+	Table* t = _table.load();
+	if (nullptr == t and _retired.empty()) return;
+
+	// Some straggler might still be probing the table.
+	epoch_synchronize();
+	delete t;
+}
+
+// ================================================================
+
+/// Return the index of the slot holding an Atom equal to `h`, else
+/// the index of the empty slot terminating the probe sequence.
+size_t ConcurrentAtomSet::find_slot(const Table* t, const Handle& h) const
+{
+	const Atom* ha = h.get();
+	ContentHash hash = ha->get_hash();
+	size_t i = hash & t->mask;
+	while (true)
+	{
+		Atom* a = t->slots[i].load(std::memory_order_relaxed);
+		if (nullptr == a) return i;
+		if (a == ha or (a != tombstone() and
+		     a->get_hash() == hash and *a == *ha))
+			return i;
+		i = (i+1) & t->mask;
+	}
+}
+
+Handle ConcurrentAtomSet::find_atom(const Handle& h) const
+{
+	EpochGuard guard;
+	const Table* t = _table.load(std::memory_order_acquire);
+	if (nullptr == t) return Handle::UNDEFINED;
+
+	const Atom* ha = h.get();
+	ContentHash hash = ha->get_hash();
+	size_t i = hash & t->mask;
+	while (true)
+	{
+		Atom* a = t->slots[i].load(std::memory_order_acquire);
+		if (nullptr == a) return Handle::UNDEFINED;
+
+		// The Atom cannot be freed while we hold the guard, even if
+		// it is being erased right now. The cast is known to be good;
+		// the dynamic cast in `Atom::get_handle()` is not cheap.
+		if (a == ha or (a != tombstone() and
+		     a->get_hash() == hash and *a == *ha))
+			return Handle(std::static_pointer_cast<Atom>(a->shared_from_this()));
+		i = (i+1) & t->mask;
+	}
+}
+
+Handle ConcurrentAtomSet::insert_atom(const Handle& h)
+{
+	Table* t = _table.load(std::memory_order_relaxed);
+
+	// Keep the table at most half-full, counting tombstones.
+	if (nullptr == t or t->mask + 1 < 2 * (_used + 1))
+	{
+		// Purge tombstones, or grow, if mostly full of Atoms.
+		size_t cap = 16;
+		if (t)
+		{
+			cap = t->mask + 1;
+			if (cap <= 4 * (_size + 1)) cap *= 2;
+		}
+		rehash(cap);
+		t = _table.load(std::memory_order_relaxed);
+	}
+
+	size_t i = find_slot(t, h);
+	if (t->owners[i]) return t->owners[i];
+
+	t->owners[i] = h;
+	t->slots[i].store(h.get(), std::memory_order_release);
+	_size++;
+	_used++;
+	return Handle::UNDEFINED;
+}
+
+size_t ConcurrentAtomSet::erase(const Handle& h)
+{
+	Table* t = _table.load(std::memory_order_relaxed);
+	if (nullptr == t) return 0;
+
+	size_t i = find_slot(t, h);
+	if (nullptr == t->owners[i]) return 0;
+
+	t->slots[i].store(tombstone());
+	_size--;
+	retire(t->owners[i], nullptr);
+	return 1;
+}
+
+void ConcurrentAtomSet::clear(void)
+{
+	Table* t = _table.exchange(nullptr);
+	_size = 0;
+	_used = 0;
+	Handle none;
+	if (t) retire(none, std::unique_ptr<Table>(t));
+}
+
+void ConcurrentAtomSet::rehash(size_t cap)
+{
+	Table* nt = new Table(cap);
+	Table* ot = _table.load(std::memory_order_relaxed);
+	if (ot)
+	{
+		for (size_t j = 0; j <= ot->mask; j++)
+		{
+			Handle& h = ot->owners[j];
+			if (nullptr == h) continue;
+			size_t i = find_slot(nt, h);
+			nt->slots[i].store(h.get(), std::memory_order_relaxed);
+			nt->owners[i].swap(h);
+		}
+	}
+	_used = _size;
+
+	// Readers still probing the old table will find all of the Atoms
+	// there; it keeps pointing at them, and the new table keeps them
+	// alive.
+	_table.store(nt);
+	Handle none;
+	if (ot) retire(none, std::unique_ptr<Table>(ot));
+}
+
+// ================================================================
+
+/// Take ownership of `h` and `t`, and free them once no reader
+/// can see them any more. (Handle has no move ctor; it copies.)
+void ConcurrentAtomSet::retire(Handle& h, std::unique_ptr<Table>&& t)
+{
+	_retired.emplace_back();
+	Retired& r = _retired.back();
+	r.atom.swap(h);
+	r.table = std::move(t);
+	r.epoch = epoch_advance();
+	reclaim();
+}
+
+void ConcurrentAtomSet::reclaim(void)
+{
+	uint64_t emin = epoch_min_active();
+	size_t j = 0;
+	for (size_t i = 0; i < _retired.size(); i++)
+	{
+		if (_retired[i].epoch < emin) continue;
+		if (i != j)
+		{
+			_retired[j].epoch = _retired[i].epoch;
+			_retired[j].atom.swap(_retired[i].atom);
+			_retired[j].table.swap(_retired[i].table);
+		}
+		j++;
+	}
+	_retired.resize(j);
+}
+
+// ================================================================
+
+ConcurrentAtomSet::const_iterator ConcurrentAtomSet::begin(void) const
+{
+	const Table* t = _table.load(std::memory_order_relaxed);
+	if (nullptr == t) return const_iterator(nullptr, nullptr);
+	return const_iterator(t->owners.get(), t->owners.get() + t->mask + 1);
+}
+
+ConcurrentAtomSet::const_iterator ConcurrentAtomSet::end(void) const
+{
+	const Table* t = _table.load(std::memory_order_relaxed);
+	if (nullptr == t) return const_iterator(nullptr, nullptr);
+	const Handle* e = t->owners.get() + t->mask + 1;
+	return const_iterator(e, e);
+}
+
+/* ===================== END OF FILE ===================== */
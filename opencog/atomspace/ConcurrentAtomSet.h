@@ -0,0 +1,162 @@
+/*
+ * opencog/atomspace/ConcurrentAtomSet.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Hash set of Atoms with lock-free lookup, for the TypeIndex.
+ */
+
+#ifndef _OPENCOG_CONCURRENT_ATOM_SET_H
+#define _OPENCOG_CONCURRENT_ATOM_SET_H
+
+#include <atomic>
+#include <iterator>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * Epoch-based reclamation (a poor-man's RCU) for lock-free readers.
+ *
+ * A reader holds an EpochGuard for as long as it looks at shared
+ * data. A writer that unlinks something from a shared structure
+ * does not free it; instead, it stamps it with `epoch_advance()`, and
+ * holds on to it until `epoch_min_active()` is larger than the stamp.
+ * At that point, no reader that might have seen it is still running.
+ */
+class EpochGuard
+{
+	public:
+		EpochGuard(void);
+		~EpochGuard();
+		EpochGuard(const EpochGuard&) = delete;
+		EpochGuard& operator=(const EpochGuard&) = delete;
+	private:
+		void* _rec;
+};
+
+uint64_t epoch_advance(void);
+uint64_t epoch_min_active(void);
+void epoch_synchronize(void);
+
+/**
+ * ConcurrentAtomSet - a set of Atoms, with lock-free lookup.
+ *
+ * This is an open-addressing hash table, with linear probing.
+ * Lookups (`find_atom()`) do not take any locks, and do not write to
+ * any shared cachelines; they only announce themselves in a
+ * per-thread epoch slot. Thus, they scale with the number of reader
+ * threads, which the shared_mutex in the LockedAtomSet does not:
+ * every reader bumps the reader count on the mutex, which bounces
+ * that cacheline between all of the cores.
+ *
+ * Writers (`insert_atom()`, `erase()`) are serialized by `_mtx`, which
+ * the caller must hold (uniquely). Iteration and `size()` require the
+ * caller to hold `_mtx` shared; these are not on the hot path.
+ *
+ * Erased Atoms are replaced by a tombstone; the table is rebuilt when
+ * it becomes half-full of Atoms and tombstones. The erased Atoms, and
+ * the old tables, are released by epoch-based reclamation.
+ */
+class ConcurrentAtomSet
+{
+	private:
+		struct Table
+		{
+			size_t mask;
+			std::unique_ptr<std::atomic<Atom*>[]> slots;
+
+			// Strong references for the Atoms in `slots`.
+			// Accessed by writers only.
+			std::unique_ptr<Handle[]> owners;
+
+			Table(size_t);
+		};
+
+		// Things that might still be seen by some reader.
+		struct Retired
+		{
+			uint64_t epoch;
+			Handle atom;
+			std::unique_ptr<Table> table;
+		};
+
+		std::atomic<Table*> _table;
+		size_t _size;
+		size_t _used;    // Atoms plus tombstones
+		std::vector<Retired> _retired;
+
+		static Atom* tombstone(void)
+		{ return reinterpret_cast<Atom*>(uintptr_t(1)); }
+
+		size_t find_slot(const Table*, const Handle&) const;
+		void rehash(size_t);
+		void retire(Handle&, std::unique_ptr<Table>&&);
+		void reclaim(void);
+
+	public:
+		mutable std::shared_mutex _mtx;
+
+		ConcurrentAtomSet(void);
+		ConcurrentAtomSet(ConcurrentAtomSet&&) noexcept;
+		~ConcurrentAtomSet();
+
+		// Lock-free. Return the Atom in the set that is equal to `h`,
+		// else return nullptr.
+		Handle find_atom(const Handle&) const;
+
+		// Caller must hold `_mtx` uniquely. If an equal Atom is
+		// already in the set, return it; else insert `h`, and
+		// return nullptr.
+		Handle insert_atom(const Handle&);
+
+		// Caller must hold `_mtx` uniquely.
+		size_t erase(const Handle&);
+
+		// Caller must hold `_mtx` uniquely. The memory is given back
+		// once no reader can be looking at it any more.
+		void clear(void);
+		void release(void) { clear(); }
+
+		size_t size(void) const { return _size; }
+		bool empty(void) const { return 0 == _size; }
+
+		class const_iterator
+		{
+			friend class ConcurrentAtomSet;
+			const Handle* _pos;
+			const Handle* _end;
+			const_iterator(const Handle* p, const Handle* e) :
+				_pos(p), _end(e) { skip(); }
+			void skip(void) { while (_pos != _end and nullptr == *_pos) _pos++; }
+		public:
+			typedef std::forward_iterator_tag iterator_category;
+			typedef Handle value_type;
+			typedef std::ptrdiff_t difference_type;
+			typedef const Handle* pointer;
+			typedef const Handle& reference;
+
+			const Handle& operator*() const { return *_pos; }
+			const Handle* operator->() const { return _pos; }
+			const_iterator& operator++() { _pos++; skip(); return *this; }
+			bool operator==(const const_iterator& o) const { return _pos == o._pos; }
+			bool operator!=(const const_iterator& o) const { return _pos != o._pos; }
+		};
+		const_iterator begin(void) const;
+		const_iterator end(void) const;
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_CONCURRENT_ATOM_SET_H
@@ -62,7 +62,7 @@ void Frame::setAtomSpace(AtomSpace* as)
 	// Under a lock, because ThreadedUTest races in the
 	// creation of scratch spaces, which causes issues,'
 	// if not protected.
-	std::unique_lock<std::shared_mutex> lck(_MTX);
+	INCOMING_UNIQUE_LOCK;
 	if (nullptr == _atom_space)
 		_atom_space = as;
 
@@ -114,21 +114,6 @@ void Frame::scrub_incoming_set(void)
 	nameserver().getChildrenRecursive(FRAME, back_inserter(framet));
 	InSetMap& iset = get_inset_map();
 	for (Type t : framet)
-	{
-		auto bucket = iset.find(t);
-		if (bucket == iset.end()) continue;
-		for (auto bi = bucket->second.begin(); bi != bucket->second.end();)
-		{
-			if (0 == bi->use_count())
-#if HAVE_SPARSEHASH
-				// sparsehash erase does not invalidate iterators.
-				bucket->second.erase(bi);
-			bi++;
-#else
-				bi = bucket->second.erase(bi);
-			else bi++;
-#endif
-		}
-	}
+		iset.erase_if(t, [](const WinkPtr& w) { return 0 == w.use_count(); });
 #endif
 }
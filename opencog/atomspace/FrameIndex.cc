@@ -0,0 +1,72 @@
+/*
+ * opencog/atomspace/FrameIndex.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Index of the Atoms in a deep stack of AtomSpace frames.
+ */
+
+#include <algorithm>
+
+#include "AtomSpace.h"
+#include "FrameIndex.h"
+
+using namespace opencog;
+
+void FrameIndex::insert(const AtomSpace* frame, size_t level,
+                        const Handle& atom)
+{
+	Stripe& s = stripe(atom);
+	std::unique_lock<std::shared_mutex> lck(s.mtx);
+
+	// Frames are usually made from the bottom up, and so the new
+	// entry almost always goes at the end.
+	Entries& ents = s.atoms[atom];
+	auto it = ents.end();
+	while (ents.begin() != it and level < (it-1)->level) it--;
+	ents.insert(it, {level, frame, atom});
+}
+
+void FrameIndex::remove(const AtomSpace* frame, const Handle& atom)
+{
+	Stripe& s = stripe(atom);
+	std::unique_lock<std::shared_mutex> lck(s.mtx);
+
+	auto ait = s.atoms.find(atom);
+	if (s.atoms.end() == ait) return;
+
+	Entries& ents = ait->second;
+	for (auto it = ents.begin(); it != ents.end(); it++)
+	{
+		if (it->frame != frame) continue;
+		ents.erase(it);
+		break;
+	}
+	if (ents.empty()) s.atoms.erase(ait);
+}
+
+Handle FrameIndex::find(const Handle& atom, const AtomSpace* frame) const
+{
+	const Stripe& s = stripe(atom);
+	std::shared_lock<std::shared_mutex> lck(s.mtx);
+
+	auto ait = s.atoms.find(atom);
+	if (s.atoms.end() == ait) return Handle::UNDEFINED;
+
+	// Walk down from the highest copy at or below our level. Unless
+	// the stack forks, the first one is the one.
+	const Entries& ents = ait->second;
+	size_t level = frame->_level;
+	auto it = std::upper_bound(ents.begin(), ents.end(), level,
+		[](size_t lvl, const Entry& e) { return lvl < e.level; });
+	while (ents.begin() != it)
+	{
+		it--;
+		if (frame->ancestor(it->level) == it->frame)
+			return it->atom;
+	}
+	return Handle::UNDEFINED;
+}
+
+/* ===================== END OF FILE ===================== */
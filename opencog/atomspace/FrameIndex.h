@@ -0,0 +1,97 @@
+/*
+ * opencog/atomspace/FrameIndex.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Index of the Atoms in a deep stack of AtomSpace frames.
+ */
+
+#ifndef _OPENCOG_FRAME_INDEX_H
+#define _OPENCOG_FRAME_INDEX_H
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Handle.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+class AtomSpace;
+
+/**
+ * A merged index of the Atoms in a stack of AtomSpace frames, shared
+ * by all of the frames in the stack. Without it, looking up an Atom
+ * in a frame that sits on top of thousands of others means probing
+ * the TypeIndex of each of those frames in turn, until the Atom is
+ * found, or the bottom is reached. With it, there is just one probe,
+ * no matter how deep the stack is.
+ *
+ * For each Atom, the index holds every copy of it, in every frame of
+ * the stack, sorted by the level of the frame. Copies include the
+ * Atoms marked absent, which hide those below them. A frame wanting
+ * the Atom takes the highest copy that is at or below its own level,
+ * and that is in a frame that is its ancestor, or itself. The stack
+ * may fork; the copies in the other branches are skipped over.
+ *
+ * Only the frames at or above the level `AtomSpace::DEEP_FRAME` use
+ * this index; the shallow frames below are searched directly. Thus,
+ * the scratch spaces created on top of an ordinary AtomSpace do not
+ * pay for it.
+ *
+ * As in the PositionIndex, the entries are spread over a pool of
+ * stripes, each with its own lock, to avoid lock contention.
+ */
+class FrameIndex
+{
+	private:
+		struct Entry
+		{
+			size_t level;
+			const AtomSpace* frame;
+			Handle atom;
+		};
+		typedef std::vector<Entry> Entries;
+
+		// Keyed by Atom content; the key is the first copy inserted.
+		struct Stripe
+		{
+			mutable std::shared_mutex mtx;
+			std::unordered_map<Handle, Entries> atoms;
+		};
+
+		static constexpr size_t NSTRIPES = 16;
+		Stripe _stripes[NSTRIPES];
+
+		Stripe& stripe(const Handle& h)
+		{ return _stripes[h->get_hash() % NSTRIPES]; }
+		const Stripe& stripe(const Handle& h) const
+		{ return _stripes[h->get_hash() % NSTRIPES]; }
+
+	public:
+		FrameIndex(void) = default;
+		FrameIndex(const FrameIndex&) = delete;
+		FrameIndex& operator=(const FrameIndex&) = delete;
+
+		/// Record that `frame`, at `level`, holds `atom`.
+		void insert(const AtomSpace* frame, size_t level, const Handle& atom);
+
+		/// Forget the copy of `atom` held in `frame`.
+		void remove(const AtomSpace* frame, const Handle& atom);
+
+		/// Return the copy of `atom` that is visible from `frame`:
+		/// the one in the closest frame that is `frame`, or is below
+		/// it. Return the undefined handle if there is no such copy
+		/// in this index.
+		Handle find(const Handle& atom, const AtomSpace* frame) const;
+};
+
+/** @}*/
+} // namespace opencog
+
+#endif // _OPENCOG_FRAME_INDEX_H
@@ -0,0 +1,182 @@
+/*
+ * opencog/atomspace/PositionIndex.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Index of Links by the Atoms they hold, and the positions they hold
+ * them at.
+ */
+
+#include "PositionIndex.h"
+
+using namespace opencog;
+
+// Approximate sizes of the hash-table entries, for the RAM accounting.
+// Each hash-table node carries a next pointer, and a bucket pointer.
+#define TARGET_BYTES (sizeof(std::pair<const Atom*, Slots>) + 2 * sizeof(void*))
+#define SLOT_BYTES (sizeof(Slot))
+#define LINK_BYTES (sizeof(Handle) + 2 * sizeof(void*))
+
+PositionIndex::PositionIndex(void) :
+	_ntables(0), _bytes(0)
+{
+}
+
+PositionIndex::~PositionIndex()
+{
+}
+
+PositionIndex::TablePtr PositionIndex::get_table(Type t) const
+{
+	if (0 == _ntables) return nullptr;
+
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	auto it = _tables.find(t);
+	if (_tables.end() == it) return nullptr;
+	return it->second;
+}
+
+bool PositionIndex::enable(Type t)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	if (_tables.end() != _tables.find(t)) return false;
+	_tables.emplace(t, std::make_shared<Table>());
+	_ntables = _tables.size();
+	return true;
+}
+
+void PositionIndex::disable(Type t)
+{
+	TablePtr tab;
+	{
+		std::unique_lock<std::shared_mutex> lck(_mtx);
+		auto it = _tables.find(t);
+		if (_tables.end() == it) return;
+		tab = it->second;
+		_tables.erase(it);
+		_ntables = _tables.size();
+	}
+	_bytes -= drop(*tab);
+}
+
+bool PositionIndex::is_enabled(Type t) const
+{
+	return nullptr != get_table(t);
+}
+
+/// Empty the table; return the number of bytes given back.
+size_t PositionIndex::drop(Table& tab)
+{
+	size_t freed = 0;
+	for (Stripe& s : tab.stripes)
+	{
+		std::unique_lock<std::shared_mutex> lck(s.mtx);
+		for (const auto& pr : s.targets)
+		{
+			freed += TARGET_BYTES;
+			for (const Slot& sl : pr.second)
+				freed += SLOT_BYTES + LINK_BYTES * sl.links.size();
+		}
+		s.targets.clear();
+	}
+	return freed;
+}
+
+void PositionIndex::clear(void)
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	for (const auto& pr : _tables)
+		_bytes -= drop(*pr.second);
+}
+
+void PositionIndex::insert(const Handle& link)
+{
+	TablePtr tab(get_table(link->get_type()));
+	if (nullptr == tab) return;
+
+	const HandleSeq& oset = link->getOutgoingSet();
+	Arity arity = oset.size();
+	for (Arity pos = 0; pos < arity; pos++)
+	{
+		const Handle& target = oset[pos];
+		Stripe& s = tab->stripe(target);
+		std::unique_lock<std::shared_mutex> lck(s.mtx);
+
+		auto ins = s.targets.try_emplace(target.operator->());
+		if (ins.second) _bytes += TARGET_BYTES;
+
+		Slots& slots = ins.first->second;
+		Slot* slot = nullptr;
+		for (Slot& sl : slots)
+			if (sl.arity == arity and sl.pos == pos) { slot = &sl; break; }
+		if (nullptr == slot)
+		{
+			slots.push_back({arity, pos, UnorderedHandleSet()});
+			slot = &slots.back();
+			_bytes += SLOT_BYTES;
+		}
+		if (slot->links.insert(link).second)
+			_bytes += LINK_BYTES;
+	}
+}
+
+void PositionIndex::remove(const Handle& link)
+{
+	TablePtr tab(get_table(link->get_type()));
+	if (nullptr == tab) return;
+
+	const HandleSeq& oset = link->getOutgoingSet();
+	Arity arity = oset.size();
+	for (Arity pos = 0; pos < arity; pos++)
+	{
+		const Handle& target = oset[pos];
+		Stripe& s = tab->stripe(target);
+		std::unique_lock<std::shared_mutex> lck(s.mtx);
+
+		auto it = s.targets.find(target.operator->());
+		if (s.targets.end() == it) continue;
+
+		Slots& slots = it->second;
+		for (size_t i = 0; i < slots.size(); i++)
+		{
+			Slot& sl = slots[i];
+			if (sl.arity != arity or sl.pos != pos) continue;
+			if (0 < sl.links.erase(link)) _bytes -= LINK_BYTES;
+			if (sl.links.empty())
+			{
+				slots.erase(slots.begin() + i);
+				_bytes -= SLOT_BYTES;
+			}
+			break;
+		}
+		if (slots.empty())
+		{
+			s.targets.erase(it);
+			_bytes -= TARGET_BYTES;
+		}
+	}
+}
+
+bool PositionIndex::get(HandleSeq& hs, Type t, const Handle& target,
+                        Arity pos, Arity arity) const
+{
+	TablePtr tab(get_table(t));
+	if (nullptr == tab) return false;
+
+	const Stripe& s = tab->stripe(target);
+	std::shared_lock<std::shared_mutex> lck(s.mtx);
+
+	auto it = s.targets.find(target.operator->());
+	if (s.targets.end() == it) return true;
+
+	for (const Slot& sl : it->second)
+	{
+		if (sl.pos != pos) continue;
+		if (0 != arity and sl.arity != arity) continue;
+		hs.insert(hs.end(), sl.links.begin(), sl.links.end());
+	}
+	return true;
+}
+
+/* ===================== END OF FILE ===================== */
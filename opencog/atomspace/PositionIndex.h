@@ -0,0 +1,126 @@
+/*
+ * opencog/atomspace/PositionIndex.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Index of Links by the Atoms they hold, and the positions they hold
+ * them at.
+ */
+
+#ifndef _OPENCOG_POSITION_INDEX_H
+#define _OPENCOG_POSITION_INDEX_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/base/Handle.h>
+#include <opencog/atoms/atom_types/types.h>
+
+namespace opencog
+{
+/** \addtogroup grp_atomspace
+ *  @{
+ */
+
+/**
+ * An optional, secondary index, mapping (link type, arity, position,
+ * target Atom) to the set of Links of that type and arity that hold
+ * the target at that position. It is enabled for one Link type at a
+ * time, and only for those types for which it was asked for.
+ *
+ * The incoming set of an Atom is already sorted by Link type; this
+ * index sorts it further, by position. This matters for hub Atoms,
+ * such as a PredicateNode that appears in millions of EvaluationLinks:
+ * a search that knows where the hub must appear, and the arity of
+ * the Link, gets only those Links, and not all of the others.
+ *
+ * The index costs RAM: roughly the same as a second copy of the
+ * incoming sets of all of the Atoms held by Links of the indexed
+ * types. The approximate amount in use is given by `bytes()`.
+ *
+ * As in the IncomeIndex, the entries are spread over a pool of
+ * stripes, each with its own lock, to avoid lock contention.
+ */
+class PositionIndex
+{
+	private:
+		// The Links holding one target Atom at one position.
+		struct Slot
+		{
+			Arity arity;
+			Arity pos;
+			UnorderedHandleSet links;
+		};
+		typedef std::vector<Slot> Slots;
+
+		// The target Atoms are kept alive by the Links that hold
+		// them, and so plain pointers suffice as keys.
+		struct Stripe
+		{
+			mutable std::shared_mutex mtx;
+			std::unordered_map<const Atom*, Slots> targets;
+		};
+
+		static constexpr size_t NSTRIPES = 16;
+		struct Table
+		{
+			Stripe stripes[NSTRIPES];
+			Stripe& stripe(const Handle& h)
+			{ return stripes[h->get_hash() % NSTRIPES]; }
+		};
+		typedef std::shared_ptr<Table> TablePtr;
+
+		mutable std::shared_mutex _mtx;
+		std::map<Type, TablePtr> _tables;
+
+		// Fast path for the (usual) case of no indexes at all.
+		std::atomic<size_t> _ntables;
+		std::atomic<size_t> _bytes;
+
+		TablePtr get_table(Type) const;
+		size_t drop(Table&);
+
+	public:
+		PositionIndex(void);
+		~PositionIndex();
+
+		/// Start indexing Links of type `t`. Returns false if they
+		/// were being indexed already. The Links that are already in
+		/// the AtomSpace have to be inserted by the caller.
+		bool enable(Type t);
+
+		/// Stop indexing Links of type `t`, and free the RAM.
+		void disable(Type t);
+
+		bool is_enabled(Type t) const;
+		bool empty(void) const { return 0 == _ntables; }
+
+		/// Add or remove a Link. Links of types that are not being
+		/// indexed are ignored.
+		void insert(const Handle&);
+		void remove(const Handle&);
+
+		/// Append to `hs` the Links of type `t` holding `target` at
+		/// position `pos`. An `arity` of zero matches Links of any
+		/// arity. Returns false, and does nothing, if type `t` is
+		/// not being indexed.
+		bool get(HandleSeq& hs, Type t, const Handle& target,
+		         Arity pos, Arity arity = 0) const;
+
+		/// Approximate RAM used by the index, in bytes.
+		size_t bytes(void) const { return _bytes; }
+
+		/// Drop all entries; the types stay enabled.
+		void clear(void);
+};
+
+/** @}*/
+} //namespace opencog
+
+#endif // _OPENCOG_POSITION_INDEX_H
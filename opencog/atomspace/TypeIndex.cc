@@ -19,62 +19,180 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <thread>
+
 #include "TypeIndex.h"
 #include <opencog/atoms/atom_types/NameServer.h>
 
 using namespace opencog;
 
 TypeIndex::TypeIndex(void) :
-	_reserved(TYPE_RESERVE_SIZE),
-	_nameserver(nameserver()),
-	_idx(VEC_SIZE)
+	_reserved(0),
+	_nameserver(nameserver())
 {
 	_num_types = nameserver().getNumberOfClasses();
 	_offset_to_atom = ATOM;
 	resize();
 }
 
-#define GET_BFL(vec) \
-	for (int ibu = 0; ibu < (int) vec.size(); ibu++) { \
-		AtomSet& s(vec[ibu]); \
-		s._mtx.lock(); }
+static size_t round_up_pow2(size_t n)
+{
+	size_t p = 1;
+	while (p < n) p *= 2;
+	return p;
+}
+
+std::atomic<size_t> TypeIndex::_max_shards(
+	round_up_pow2(std::thread::hardware_concurrency()));
+
+void TypeIndex::set_max_shards(size_t n)
+{
+	_max_shards = round_up_pow2(n);
+}
+
+std::atomic<bool> TypeIndex::_watched[CHANGE_SLOTS];
+std::atomic<uint64_t> TypeIndex::_changes[CHANGE_SLOTS];
 
-#define DROP_BFL(vec) \
-	for (int ibu = 0; ibu < (int) vec.size(); ibu++) { \
-		AtomSet& s(vec[ibu]); \
-		s._mtx.unlock(); }
+void TypeIndex::watch_type(Type t)
+{
+	_watched[change_slot(NOTYPE)].store(true);
+	_watched[change_slot(t)].store(true);
+}
 
 void TypeIndex::resize(void) const
 {
 	int newsz = nameserver().getNumberOfClasses();
 	if (newsz < _reserved + _offset_to_atom) return;
 
-	// If we are here, we need to resize. Get the BFL.
+	std::lock_guard<std::mutex> lck(_mtx);
+	if (newsz < _reserved + _offset_to_atom) return;
 
+	if (0 == _reserved) _reserved = TYPE_RESERVE_SIZE;
 	while (_reserved + _offset_to_atom < newsz)
 		_reserved *= 2;
 
-	std::vector<AtomSet> newvec(_reserved * POOL_SIZE);
-	GET_BFL(_idx)
-	newvec.swap(_idx);
+	// A deque, so that the existing slots stay where they are.
+	while (_idx.size() < (size_t) _reserved)
+		_idx.emplace_back();
 	_num_types = newsz;
-	DROP_BFL(newvec)
 }
 
-void TypeIndex::clear(void)
+/// Move all of the Atoms of one type from `from` shards to `to`
+/// shards. Does nothing if the type no longer has `from` shards, or
+/// if some other thread is already resharding it.
+void TypeIndex::reshard(TypeSlot& ts, size_t from, size_t to)
 {
-	std::vector<AtomSet> dead(_reserved * POOL_SIZE);
-	GET_BFL(_idx)
-	dead.swap(_idx);
+	std::unique_lock<std::mutex> rlck(ts.reshard_mtx, std::try_to_lock);
+	if (not rlck.owns_lock()) return;
+
+	TypeShards* sh = ts.shards.load();
+	if (sh->nshards != from) return;
+
+	for (size_t i = 0; i < from; i++)
+		sh->sets[i]._mtx.lock();
+
+	// No one else can see the new shards yet; no need to lock them.
+	TypeShards* nsh = new TypeShards(to);
+	for (size_t i = 0; i < from; i++)
+		for (const Handle& h : sh->sets[i])
+			nsh->get(h).insert_atom(h);
 
-	// Clear the AtomSpace before releasing the lock.
-	for (auto& s : dead)
+	// Publish the new shards before marking the old ones stale, so
+	// that anyone who sees them stale will find the new ones.
+	ts.shards.store(nsh);
+	sh->stale.store(true);
+
+	for (size_t i = 0; i < from; i++)
 	{
-		for (auto& h : s)
-			h->_atom_space = nullptr;
+		sh->sets[i].release();
+		sh->sets[i]._mtx.unlock();
 	}
 
-	DROP_BFL(dead)
+	std::lock_guard<std::mutex> lck(_mtx);
+	_graveyard.emplace_back(sh);
+}
+
+void TypeIndex::insertAtoms(const HandleSeq& hs, HandleSeq& olds)
+{
+	size_t n = hs.size();
+	olds.resize(n);
+
+	// Sort by type, and then by shard.
+	std::vector<std::pair<uint64_t, size_t>> order;
+	order.reserve(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		Type t = hs[i]->get_type();
+		uint64_t key = ((uint64_t) t) << 32;
+		key |= shard_part(hs[i], get_slot(t).shards.load()->nshards);
+		order.push_back({key, i});
+	}
+	std::sort(order.begin(), order.end());
+
+	size_t i = 0;
+	while (i < n)
+	{
+		const Handle& first(hs[order[i].second]);
+		TypeSlot& ts(get_slot(first->get_type()));
+		TypeShards* sh = ts.shards.load(std::memory_order_acquire);
+		AtomSet& s(sh->get(first));
+
+		// The run of Atoms going into the same shard.
+		size_t j = i + 1;
+		while (j < n and order[j].first == order[i].first and
+		       &sh->get(hs[order[j].second]) == &s)
+			j++;
+
+		size_t ssz = 0;
+		bool stale;
+		{
+			TYPE_INDEX_UNIQUE_LOCK(s);
+			stale = sh->stale.load(std::memory_order_relaxed);
+			if (not stale)
+			{
+				for (size_t k = i; k < j; k++)
+					olds[order[k].second] = s.insert_atom(hs[order[k].second]);
+				ssz = s.size();
+			}
+		}
+		if (not stale) changed(first->get_type());
+
+		// Resharded from under us; do these the slow way.
+		if (stale)
+		{
+			for (size_t k = i; k < j; k++)
+				olds[order[k].second] = insertAtom(hs[order[k].second]);
+		}
+		else if (SHARD_SIZE < ssz and sh->nshards < _max_shards)
+			reshard(ts, sh->nshards, 2 * sh->nshards);
+		i = j;
+	}
+}
+
+void TypeIndex::clear(void)
+{
+	std::vector<std::unique_ptr<TypeShards>> dead;
+	for (TypeSlot& ts : _idx)
+	{
+		std::lock_guard<std::mutex> rlck(ts.reshard_mtx);
+		TypeShards* sh = ts.shards.load();
+		for (size_t i = 0; i < sh->nshards; i++)
+			sh->sets[i]._mtx.lock();
+
+		ts.shards.store(new TypeShards(1));
+		sh->stale.store(true);
+
+		// Clear the AtomSpace before releasing the lock.
+		for (size_t i = 0; i < sh->nshards; i++)
+			for (const Handle& h : sh->sets[i])
+				h->_atom_space = nullptr;
+
+		for (size_t i = 0; i < sh->nshards; i++)
+			sh->sets[i]._mtx.unlock();
+		dead.emplace_back(sh);
+	}
+	changed(NOTYPE);
 
 	// Do the final cleanup after releasing the lock. This enables
 	// the very unlikely situation of having other threads start
@@ -83,12 +201,20 @@ void TypeIndex::clear(void)
 	// in the `AtomSpace::add()` method. We do it here cause its
 	// easier. Anyway, we can't do the `remove()` under the lock,
 	// that would result in lock inversion.
-	for (auto& s : dead)
+	for (auto& sh : dead)
 	{
-		for (auto& h : s)
-			h->remove();
-		s.clear();
+		for (size_t i = 0; i < sh->nshards; i++)
+		{
+			AtomSet& s(sh->sets[i]);
+			for (const Handle& h : s)
+				h->remove();
+			std::unique_lock<std::shared_mutex> lck(s._mtx);
+			s.clear();
+		}
 	}
+
+	std::lock_guard<std::mutex> lck(_mtx);
+	_graveyard.clear();
 }
 
 // ================================================================
@@ -110,16 +236,16 @@ void TypeIndex::get_handles_by_type(HandleSeq& hseq,
 	// allocations and copies whenever the allocated size is exceeded.
 	hseq.reserve(initial_size + size_of_append);
 
+	auto append = [&](const AtomSet& s)
+	{
+		for (const Handle& h : s)
+			hseq.push_back(h);
+	};
+
 	if (type >= _offset_to_atom)
 	{
-		int start = get_bucket_start(type);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			for (const Handle& h : s)
-				hseq.push_back(h);
-		}
+		while (not scan_type(type, append))
+			hseq.erase(hseq.begin() + initial_size, hseq.end());
 	}
 
 	// Not subclassing? We are done!
@@ -130,33 +256,51 @@ void TypeIndex::get_handles_by_type(HandleSeq& hseq,
 	{
 		if (not _nameserver.isA(t, type)) continue;
 
-		int start = get_bucket_start(t);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
+		size_t start = hseq.size();
+		while (not scan_type(t, append))
+			hseq.erase(hseq.begin() + start, hseq.end());
+	}
+}
+
+void TypeIndex::sample(HandleSeq& hseq, Type type, size_t n) const
+{
+	if (type < _offset_to_atom or 0 == n) return;
+
+	size_t initial_size = hseq.size();
+	auto take = [&](const AtomSet& s)
+	{
+		// Spread the sample over the shards, in proportion to their
+		// size; the shards are about the same size, anyway.
+		size_t nshards = get_slot(type).shards.load()->nshards;
+		size_t quota = (n + nshards - 1) / nshards;
+		for (const Handle& h : s)
 		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			for (const Handle& h : s)
-				hseq.push_back(h);
+			if (0 == quota or initial_size + n <= hseq.size()) break;
+			hseq.push_back(h);
+			quota--;
 		}
-	}
+	};
+
+	while (not scan_type(type, take))
+		hseq.erase(hseq.begin() + initial_size, hseq.end());
 }
 
-// Same as above, except using an unordered set.
+// Same as above, except using an unordered set. Nothing needs to be
+// undone, if the type is resharded mid-scan; the set ignores repeats.
 void TypeIndex::get_handles_by_type(UnorderedHandleSet& hset,
                                     Type type,
                                     bool subclass) const
 {
 	if (not subclass and type < _offset_to_atom) return;
 
+	auto append = [&](const AtomSet& s)
+	{
+		hset.insert(s.begin(), s.end());
+	};
+
 	if (type >= _offset_to_atom)
 	{
-		int start = get_bucket_start(type);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			hset.insert(s.begin(), s.end());
-		}
+		while (not scan_type(type, append)) {}
 	}
 
 	// Not subclassing? We are done!
@@ -166,14 +310,7 @@ void TypeIndex::get_handles_by_type(UnorderedHandleSet& hset,
 	for (Type t = tstar; t<_num_types; t++)
 	{
 		if (not _nameserver.isA(t, type)) continue;
-
-		int start = get_bucket_start(t);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			hset.insert(s.begin(), s.end());
-		}
+		while (not scan_type(t, append)) {}
 	}
 }
 
@@ -197,19 +334,17 @@ void TypeIndex::get_rootset_by_type(HandleSeq& hseq,
 	// allocations and copies whenever the allocated size is exceeded.
 	hseq.reserve(initial_size + size_of_append);
 
+	auto append = [&](const AtomSet& s)
+	{
+		for (const Handle& h : s)
+			if (h->isIncomingSetEmpty(cas))
+				hseq.push_back(h);
+	};
+
 	if (type >= _offset_to_atom)
 	{
-		int start = get_bucket_start(type);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			for (const Handle& h : s)
-			{
-				if (h->isIncomingSetEmpty(cas))
-					hseq.push_back(h);
-			}
-		}
+		while (not scan_type(type, append))
+			hseq.erase(hseq.begin() + initial_size, hseq.end());
 	}
 
 	// Not subclassing? We are done!
@@ -220,15 +355,9 @@ void TypeIndex::get_rootset_by_type(HandleSeq& hseq,
 	{
 		if (not _nameserver.isA(t, type)) continue;
 
-		int start = get_bucket_start(t);
-		for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-		{
-			const AtomSet& s(_idx[ibu]);
-			TYPE_INDEX_SHARED_LOCK(s);
-			for (const Handle& h : s)
-				if (h->isIncomingSetEmpty(cas))
-					hseq.push_back(h);
-		}
+		size_t start = hseq.size();
+		while (not scan_type(t, append))
+			hseq.erase(hseq.begin() + start, hseq.end());
 	}
 }
 
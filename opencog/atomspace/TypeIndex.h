@@ -22,6 +22,8 @@
 #ifndef _OPENCOG_TYPEINDEX_H
 #define _OPENCOG_TYPEINDEX_H
 
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -38,6 +40,7 @@
 #include <opencog/atoms/base/Atom.h>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/atom_types/types.h>
+#include <opencog/atomspace/ConcurrentAtomSet.h>
 
 namespace opencog
 {
@@ -80,28 +83,107 @@ namespace opencog
 	typedef std::unordered_set<Handle> AtomHanSet;
 #endif
 
-// The AtomSet is just a set, plus a lock on that set.
-struct AtomSet : AtomHanSet
+// The LockedAtomSet is just a set, plus a lock on that set.
+struct LockedAtomSet : AtomHanSet
 {
 	mutable std::shared_mutex _mtx;
 #if USE_SPARSE_TYPESET
-	AtomSet() { set_deleted_key(Handle()); }
+	LockedAtomSet() { set_deleted_key(Handle()); }
 #else
-	AtomSet() = default;
+	LockedAtomSet() = default;
 #endif
-	AtomSet(AtomSet&& other) noexcept :
+	LockedAtomSet(LockedAtomSet&& other) noexcept :
 		AtomHanSet(std::move(other))
 	{}
+
+	// Caller must hold the lock (shared).
+	Handle find_atom(const Handle& h) const
+	{
+		auto iter = find(h);
+		if (end() == iter) return Handle::UNDEFINED;
+		return *iter;
+	}
+
+	// Caller must hold the lock (unique).
+	Handle insert_atom(const Handle& h)
+	{
+		auto iter = find(h);
+		if (end() != iter) return *iter;
+		insert(h);
+		return Handle::UNDEFINED;
+	}
+
+	// Drop all Atoms, and give back the memory, too. Plain `clear()`
+	// keeps the bucket array around.
+	void release(void)
+	{
+		AtomHanSet empty;
+		swap(empty);
+	}
 };
 
+// Lock-free lookup, for highly-threaded workloads. With the default
+// LockedAtomSet, every lookup takes a shared lock, which writes to
+// the reader count on the lock. With 32 or more threads all doing
+// `AtomSpace::add()` at the same time, that one cacheline bounces
+// between all of the cores, and becomes the bottleneck. See the
+// `typeset_bm` benchmark in `tests/benchmark`. Writers still take
+// the lock. Off by default, since single-threaded performance is
+// about the same, and the lock-free code is less battle-tested.
+// #define USE_LOCKFREE_TYPESET 1
+
+#if USE_LOCKFREE_TYPESET
+	typedef ConcurrentAtomSet AtomSet;
+	#define TYPE_INDEX_FIND_LOCK(s)
+#else
+	typedef LockedAtomSet AtomSet;
+	#define TYPE_INDEX_FIND_LOCK(s) TYPE_INDEX_SHARED_LOCK(s)
+#endif
+
 #define TYPE_INDEX_SHARED_LOCK(s) std::shared_lock<std::shared_mutex> lck(s._mtx);
 #define TYPE_INDEX_UNIQUE_LOCK(s) std::unique_lock<std::shared_mutex> lck(s._mtx);
 
+// All of the Atoms of one Type, spread over one or more AtomSets
+// (shards), so that writers contend less. The shard is picked by the
+// high bits of the hash; the low bits are used by the sets themselves.
+struct TypeShards
+{
+	size_t nshards;  // Always a power of two.
+
+	// Set when the Atoms have been moved to a different TypeShards.
+	// Always check this after taking the lock on a shard.
+	std::atomic<bool> stale;
+	std::unique_ptr<AtomSet[]> sets;
+
+	TypeShards(size_t n) :
+		nshards(n), stale(false), sets(new AtomSet[n]) {}
+
+	AtomSet& get(const Handle& h) const
+	{
+		return sets[(h->get_hash() >> 32) & (nshards - 1)];
+	}
+};
+
+struct TypeSlot
+{
+	std::atomic<TypeShards*> shards;
+	std::mutex reshard_mtx;
+
+	TypeSlot(void) : shards(new TypeShards(1)) {}
+	~TypeSlot() { delete shards.load(); }
+};
+
 /**
  * Implements a vector of AtomSets; each AtomSet is a hash table of
  * Atom pointers.  Thus, given an Atom Type, this can quickly find
  * all of the Atoms of that Type.
  *
+ * Each Type starts out with a single AtomSet. As a Type grows, it is
+ * split into more and more shards, up to one per core, so that many
+ * threads adding Atoms of the same Type do not all wait on the same
+ * lock. If it shrinks again, the shards are merged back together.
+ * Most Types hold few or no Atoms, and so cost only one small set.
+ *
  * The primary interface for this is an iterator, and that is because
  * the index will typically contain millions of atoms, and this is far
  * too much to try to copy into some temporary array.  Iterating is much
@@ -118,63 +200,140 @@ class TypeIndex
 		mutable int _reserved;
 		int _offset_to_atom;
 		NameServer& _nameserver;
-		mutable std::vector<AtomSet> _idx;
+		mutable std::deque<TypeSlot> _idx;
+		mutable std::mutex _mtx;
+
+		// Split hot types into no more than this many shards.
+		static std::atomic<size_t> _max_shards;
+
+		// Old shards, no longer in use. Other threads may still be
+		// holding pointers to these, so they are kept, empty, until
+		// the next `clear()`.
+		std::vector<std::unique_ptr<TypeShards>> _graveyard;
 
 		static constexpr int TYPE_RESERVE_SIZE = 1024;
-		static constexpr int POOL_SIZE = 8;
-		static constexpr int VEC_SIZE = TYPE_RESERVE_SIZE * POOL_SIZE;
-		int get_bucket_start(Type t) const
+
+		// Split a Type when one of its shards gets bigger than this.
+		// Merge shards when one gets smaller than 1/8th of this.
+		static constexpr size_t SHARD_SIZE = 4096;
+
+		TypeSlot& get_slot(Type t) const
 		{
 			OC_ASSERT(_offset_to_atom <= t, "BUG with type buckets!");
 			if (_reserved + _offset_to_atom <= t) resize();
-			return POOL_SIZE * (t - _offset_to_atom);
-		}
-		int get_bucket(const Handle& h) const
-		{
-			int ibu = h->get_hash() % POOL_SIZE;
-			Type hty = h->get_type();
-			if (_reserved + _offset_to_atom <= hty) resize();
-			ibu += POOL_SIZE * (hty - _offset_to_atom);
-			return ibu;
-		}
-		AtomSet& get_atom_set(const Handle& h)
-		{
-			return _idx[get_bucket(h)];
-		}
-		const AtomSet& get_atom_set_const(const Handle& h) const
-		{
-			return _idx[get_bucket(h)];
+			return _idx[t - _offset_to_atom];
 		}
+
+		template<typename FN>
+		bool scan_type(Type, const FN&) const;
+
+		void reshard(TypeSlot&, size_t, size_t);
+
+		// Change counts; see `changed()`. NOTYPE, and types past the end
+		// of the table, share the last slot.
+		static constexpr size_t CHANGE_SLOTS = 4096;
+		static std::atomic<bool> _watched[CHANGE_SLOTS];
+		static std::atomic<uint64_t> _changes[CHANGE_SLOTS];
+		static size_t change_slot(Type t)
+		{ return t < CHANGE_SLOTS ? t : CHANGE_SLOTS - 1; }
+
 	public:
 		TypeIndex(void);
 		void resize(void) const;
 
+		// Default is one shard per core. Rounded up to a power of two.
+		// Only affects types that are resharded after this is called.
+		static void set_max_shards(size_t);
+
 		// Return a Handle, if it's already in the set.
 		// Else, return nullptr
 		Handle insertAtom(const Handle& h)
 		{
-			AtomSet& s(get_atom_set(h));
-			TYPE_INDEX_UNIQUE_LOCK(s);
-			auto iter = s.find(h);
-			if (s.end() != iter) return *iter;
-			s.insert(h);
-			return Handle::UNDEFINED;
+			TypeSlot& ts(get_slot(h->get_type()));
+			while (true)
+			{
+				TypeShards* sh = ts.shards.load(std::memory_order_acquire);
+				size_t ssz;
+				{
+					AtomSet& s(sh->get(h));
+					TYPE_INDEX_UNIQUE_LOCK(s);
+					if (sh->stale.load(std::memory_order_relaxed)) continue;
+					Handle old(s.insert_atom(h));
+					if (old) return old;
+					ssz = s.size();
+				}
+				changed(h->get_type());
+				if (SHARD_SIZE < ssz and sh->nshards < _max_shards.load(std::memory_order_relaxed))
+					reshard(ts, sh->nshards, 2 * sh->nshards);
+				return Handle::UNDEFINED;
+			}
+		}
+
+		// Insert many Atoms at once, taking each shard lock only once
+		// for each run of Atoms that land in it. On return, `olds[i]`
+		// is what `insertAtom(hs[i])` would have returned.
+		void insertAtoms(const HandleSeq& hs, HandleSeq& olds);
+
+		// Count Atoms of type `t` being added or removed, for caches
+		// that remember what they found in the AtomSpace, such as the
+		// grounding cache on PatternLinks. Only the types that some
+		// cache is watching are counted, and the counts are shared by
+		// all AtomSpaces. Changes that can affect every type, such as
+		// `clear()` or the hiding of Atoms in COW spaces, are counted
+		// as changes to NOTYPE.
+		static void changed(Type t)
+		{
+			size_t i = change_slot(t);
+			if (_watched[i].load()) _changes[i].fetch_add(1);
+		}
+		static void watch_type(Type);
+		static uint64_t changes(Type t)
+		{ return _changes[change_slot(t)].load(); }
+
+		// For splitting up a bulk insert among threads. Atoms in
+		// different parts never share a shard, if `nparts` is a
+		// power of two.
+		static size_t shard_part(const Handle& h, size_t nparts)
+		{
+			return (h->get_hash() >> 32) & (nparts - 1);
 		}
 
 		bool removeAtom(const Handle& h)
 		{
-			AtomSet& s(get_atom_set(h));
-			TYPE_INDEX_UNIQUE_LOCK(s);
-			return 1 == s.erase(h);
+			TypeSlot& ts(get_slot(h->get_type()));
+			while (true)
+			{
+				TypeShards* sh = ts.shards.load(std::memory_order_acquire);
+				size_t ssz;
+				{
+					AtomSet& s(sh->get(h));
+					TYPE_INDEX_UNIQUE_LOCK(s);
+					if (sh->stale.load(std::memory_order_relaxed)) continue;
+					if (1 != s.erase(h)) return false;
+					ssz = s.size();
+				}
+				changed(h->get_type());
+				if (8 * ssz < SHARD_SIZE and 1 < sh->nshards)
+					reshard(ts, sh->nshards, sh->nshards / 2);
+				return true;
+			}
 		}
 
 		Handle findAtom(const Handle& h) const
 		{
-			const AtomSet& s(get_atom_set_const(h));
-			TYPE_INDEX_SHARED_LOCK(s);
-			auto iter = s.find(h);
-			if (s.end() == iter) return Handle::UNDEFINED;
-			return *iter;
+			const TypeSlot& ts(get_slot(h->get_type()));
+			while (true)
+			{
+				const TypeShards* sh = ts.shards.load(std::memory_order_acquire);
+				const AtomSet& s(sh->get(h));
+				TYPE_INDEX_FIND_LOCK(s);
+				if (sh->stale.load(std::memory_order_relaxed)) continue;
+				Handle hf(s.find_atom(h));
+
+				// Without the lock, the shard might have been emptied
+				// out from under us. It is marked stale before that.
+				if (hf or not sh->stale.load()) return hf;
+			}
 		}
 
 		// How many atoms are there of type t?
@@ -182,13 +341,8 @@ class TypeIndex
 		{
 			if (t < _offset_to_atom) return 0;
 			size_t cnt = 0;
-			int start = get_bucket_start(t);
-			for (int ibu = start; ibu < start + POOL_SIZE; ibu++)
-			{
-				const AtomSet& s(_idx[ibu]);
-				TYPE_INDEX_SHARED_LOCK(s);
-				cnt += s.size();
-			}
+			while (not scan_type(t, [&](const AtomSet& s) { cnt += s.size(); }))
+				cnt = 0;
 			return cnt;
 		}
 
@@ -196,11 +350,8 @@ class TypeIndex
 		size_t size(void) const
 		{
 			size_t cnt = 0;
-			for (const auto& s : _idx)
-			{
-				TYPE_INDEX_SHARED_LOCK(s);
-				cnt += s.size();
-			}
+			for (Type t = _offset_to_atom; t < _num_types; t++)
+				cnt += size(t);
 			return cnt;
 		}
 
@@ -221,14 +372,43 @@ class TypeIndex
 			return result;
 		}
 
+		// Number of shards that type t is currently split into.
+		size_t num_shards(Type t) const
+		{
+			return get_slot(t).shards.load()->nshards;
+		}
+
 		void clear(void);
 
 		void get_handles_by_type(HandleSeq&, Type, bool subclass) const;
+
+		// Append up to `n` Atoms of type `t` (not subclasses), taken
+		// from all of the shards, in hash order. That is as good as
+		// random, for gathering statistics.
+		void sample(HandleSeq&, Type t, size_t n) const;
 		void get_handles_by_type(UnorderedHandleSet&, Type, bool subclass) const;
 		void get_rootset_by_type(HandleSeq&, Type, bool subclass,
 		                         const AtomSpace*) const;
 };
 
+/// Apply `fn` to each of the AtomSets holding Atoms of type `t`,
+/// one at a time, each under a shared lock. Returns false if the
+/// type was resharded part-way through; in that case, the caller
+/// must discard what it got so far, and try again.
+template<typename FN>
+bool TypeIndex::scan_type(Type t, const FN& fn) const
+{
+	const TypeShards* sh = get_slot(t).shards.load(std::memory_order_acquire);
+	for (size_t i = 0; i < sh->nshards; i++)
+	{
+		const AtomSet& s(sh->sets[i]);
+		TYPE_INDEX_SHARED_LOCK(s);
+		if (sh->stale.load(std::memory_order_relaxed)) return false;
+		fn(s);
+	}
+	return true;
+}
+
 /** @}*/
 } //namespace opencog
 
@@ -0,0 +1,38 @@
+/*
+ * opencog/cython/opencog/ValueBuffers.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ */
+
+#include <opencog/atoms/value/BoolValue.h>
+#include <opencog/atoms/value/Float32Value.h>
+#include <opencog/atoms/value/FloatValue.h>
+
+#include "ValueBuffers.h"
+
+using namespace opencog;
+
+ValuePtr opencog::float_value_from_buffer(const double* data, size_t n)
+{
+    return createFloatValue(std::vector<double>(data, data + n));
+}
+
+ValuePtr opencog::float32_value_from_buffer(const float* data, size_t n)
+{
+    return createFloat32Value(std::vector<float>(data, data + n));
+}
+
+ValuePtr opencog::bool_value_from_words(const uint64_t* words, size_t nbits)
+{
+    std::vector<uint64_t> bits(words, words + (nbits + 63) / 64);
+
+    // Clear the unused tail, so that equality compares as expected.
+    size_t tail = nbits % 64;
+    if (0 < tail)
+        bits.back() &= ~uint64_t(0) << (64 - tail);
+
+    BoolValuePtr bvp(createBoolValue(std::vector<uint64_t>()));
+    bvp->set_packed_data(std::move(bits), nbits);
+    return bvp;
+}
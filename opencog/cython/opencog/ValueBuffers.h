@@ -0,0 +1,31 @@
+/*
+ * opencog/cython/opencog/ValueBuffers.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Create vector Values from contiguous blocks of memory, for the
+ * python buffer protocol.
+ */
+
+#ifndef _OPENCOG_PYTHON_VALUE_BUFFERS_H
+#define _OPENCOG_PYTHON_VALUE_BUFFERS_H
+
+#include <cstdint>
+#include <opencog/atoms/value/Value.h>
+
+namespace opencog {
+
+// Each of these copies the block in one go, instead of walking
+// through python lists one element at a time.
+ValuePtr float_value_from_buffer(const double*, size_t);
+ValuePtr float32_value_from_buffer(const float*, size_t);
+
+// The words are in the packed layout used by BoolValue: bit zero is
+// the most significant bit of the first word. Bits past `nbits` in
+// the last word are ignored.
+ValuePtr bool_value_from_words(const uint64_t*, size_t nbits);
+
+} // namespace opencog
+
+#endif // _OPENCOG_PYTHON_VALUE_BUFFERS_H
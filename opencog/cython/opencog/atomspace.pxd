@@ -3,6 +3,7 @@ from libcpp.vector cimport vector
 from libcpp.memory cimport shared_ptr
 from libcpp.set cimport set as cpp_set
 from libcpp.string cimport string
+from libc.stdint cimport uint64_t
 from cython.operator cimport dereference as deref
 
 # Basic wrapping for back_insert_iterator conversion.
@@ -187,6 +188,8 @@ cdef extern from "opencog/atoms/value/BoolValue.h" namespace "opencog":
         cBoolValue(bool value) nogil
         cBoolValue(const vector[bool]& values) nogil
         const vector[bool]& value() nogil const
+        const vector[uint64_t]& get_packed_bits() nogil const
+        size_t get_bit_count() nogil const
 
     cdef shared_ptr[cBoolValue] c_createBoolValue_single "opencog::createBoolValue" (bool) nogil
     cdef shared_ptr[cBoolValue] c_createBoolValue_vector "opencog::createBoolValue" (const vector[bool]&) nogil
@@ -203,6 +206,15 @@ cdef extern from "opencog/atoms/value/FloatValue.h" namespace "opencog":
     cdef shared_ptr[cFloatValue] c_createFloatValue_vector "opencog::createFloatValue" (const vector[double]&) nogil
 
 
+# Float32Value
+cdef extern from "opencog/atoms/value/Float32Value.h" namespace "opencog":
+    cdef cppclass cFloat32Value "opencog::Float32Value":
+        cFloat32Value(const vector[float]& values) nogil
+        const vector[float]& value() nogil const
+
+    cdef shared_ptr[cFloat32Value] c_createFloat32Value_vector "opencog::createFloat32Value" (const vector[float]&) nogil
+
+
 # StringValue
 cdef extern from "opencog/atoms/value/StringValue.h" namespace "opencog":
     cdef cppclass cStringValue "opencog::StringValue":
@@ -263,6 +275,17 @@ cdef extern from "opencog/atoms/value/UnisetValue.h" namespace "opencog":
     cdef shared_ptr[cUnisetValue] c_createUnisetValue_vector "opencog::createUnisetValue" (const vector[cValuePtr]&) nogil
 
 
+# Arrow C Data Interface
+cdef extern from "opencog/atoms/columnvec/ArrowExport.h":
+    cdef struct ArrowSchema:
+        void (*release)(ArrowSchema*)
+    cdef struct ArrowArray:
+        void (*release)(ArrowArray*)
+
+cdef extern from "opencog/atoms/columnvec/ArrowExport.h" namespace "opencog":
+    void c_arrow_export "opencog::arrow_export" (const cValuePtr&, ArrowArray*, ArrowSchema*) except +
+
+
 # VoidValue
 cdef extern from "opencog/atoms/value/VoidValue.h" namespace "opencog":
     cdef cppclass cVoidValue "opencog::VoidValue":
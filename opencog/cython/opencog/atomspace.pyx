@@ -8,6 +8,7 @@
 include "value.pyx"
 include "bool_value.pyx"
 include "float_value.pyx"
+include "float32_value.pyx"
 include "link_value.pyx"
 include "queue_value.pyx"
 include "string_value.pyx"
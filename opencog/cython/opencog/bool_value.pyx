@@ -10,6 +10,16 @@ def createBoolValue(arg):
     return instance
 
 cdef class BoolValue(Value):
+    """A vector of booleans.
+
+    The bits are stored packed into 64-bit words; bit zero is the most
+    significant bit of the first word. The packed words can be viewed
+    read-only, without copying, with the buffer protocol (format "Q"),
+    and `from_words()` builds a BoolValue from such words in one block.
+    """
+
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
 
     def __init__(self, arg=None):
         cdef shared_ptr[cBoolValue] c_ptr
@@ -20,6 +30,50 @@ cdef class BoolValue(Value):
                 c_ptr = c_createBoolValue_single(<bool>arg)
             self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
 
+    @staticmethod
+    def from_words(words, size_t nbits):
+        """Create a BoolValue holding the first `nbits` bits of a
+        contiguous buffer of 64-bit words."""
+        cdef const uint64_t[::1] view = words
+        if (<size_t> view.shape[0]) * 64 < nbits:
+            raise ValueError("Need %d words for %d bits, got %d" %
+                             ((nbits + 63) // 64, nbits, view.shape[0]))
+        cdef BoolValue instance = BoolValue.__new__(BoolValue)
+        if 0 == nbits:
+            instance.shared_ptr = c_bool_value_from_words(NULL, 0)
+        else:
+            instance.shared_ptr = c_bool_value_from_words(&view[0], nbits)
+        return instance
+
+    @property
+    def bit_count(self):
+        return (<cBoolValue*>self.get_c_raw_ptr()).get_bit_count()
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("BoolValue is immutable")
+        if self.get_c_raw_ptr() == NULL:
+            raise BufferError("BoolValue is empty")
+
+        cdef const vector[uint64_t]* vp = \
+            &((<cBoolValue*>self.get_c_raw_ptr()).get_packed_bits())
+        self._shape[0] = vp.size()
+        self._strides[0] = sizeof(uint64_t)
+        buffer.buf = <void*> vp.data()
+        buffer.obj = self
+        buffer.len = vp.size() * sizeof(uint64_t)
+        buffer.readonly = 1
+        buffer.itemsize = sizeof(uint64_t)
+        buffer.format = "Q" if flags & PyBUF_FORMAT else NULL
+        buffer.ndim = 1
+        buffer.shape = self._shape if flags & PyBUF_ND else NULL
+        buffer.strides = self._strides if (flags & PyBUF_STRIDES) == PyBUF_STRIDES else NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        pass
+
     def to_list(self):
         return BoolValue.vector_of_bool_to_list(
             (<cBoolValue*>self.get_c_raw_ptr()).value())
@@ -0,0 +1,107 @@
+def createFloat32Value(arg):
+    if PyObject_CheckBuffer(arg):
+        return Float32Value.from_buffer(arg)
+    cdef shared_ptr[cFloat32Value] c_ptr
+    if (isinstance(arg, list)):
+        c_ptr = c_createFloat32Value_vector(Float32Value.list_of_floats_to_vector(arg))
+    else:
+        c_ptr = c_createFloat32Value_vector(vector[float](1, <float>arg))
+    cdef Float32Value instance = Float32Value.__new__(Float32Value)
+    instance.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
+    return instance
+
+cdef class Float32Value(Value):
+    """A vector of single-precision floats.
+
+    Like FloatValue, this supports the buffer protocol: it can be viewed
+    read-only, without copying, and anything that exports a contiguous
+    buffer of floats (e.g. a numpy float32 array) can be passed to the
+    constructor.
+    """
+
+    cdef vector[float] _snapshot
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+    cdef int _exports
+
+    def __init__(self, arg=None):
+        cdef shared_ptr[cFloat32Value] c_ptr
+        if arg is not None:
+            if PyObject_CheckBuffer(arg):
+                self.shared_ptr = Float32Value.buffer_to_value(arg)
+            elif isinstance(arg, list):
+                c_ptr = c_createFloat32Value_vector(Float32Value.list_of_floats_to_vector(arg))
+                self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
+            else:
+                c_ptr = c_createFloat32Value_vector(vector[float](1, <float>arg))
+                self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
+
+    @staticmethod
+    def from_buffer(obj):
+        """Create a Float32Value from anything that exports a contiguous
+        buffer of floats."""
+        cdef Float32Value instance = Float32Value.__new__(Float32Value)
+        instance.shared_ptr = Float32Value.buffer_to_value(obj)
+        return instance
+
+    @staticmethod
+    cdef cValuePtr buffer_to_value(obj):
+        cdef const float[::1] view = obj
+        cdef size_t n = view.shape[0]
+        if 0 == n:
+            return c_float32_value_from_buffer(NULL, 0)
+        return c_float32_value_from_buffer(&view[0], n)
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("Float32Value is immutable")
+        if self.get_c_raw_ptr() == NULL:
+            raise BufferError("Float32Value is empty")
+
+        # Snapshot anything that might change under the reader;
+        # see FloatValue.
+        cdef const vector[float]* vp = \
+            &((<cFloat32Value*>self.get_c_raw_ptr()).value())
+        if self.type != types.Float32Value:
+            if 0 == self._exports:
+                self._snapshot = deref(vp)
+            vp = &self._snapshot
+
+        self._shape[0] = vp.size()
+        self._strides[0] = sizeof(float)
+        buffer.buf = <void*> vp.data()
+        buffer.obj = self
+        buffer.len = vp.size() * sizeof(float)
+        buffer.readonly = 1
+        buffer.itemsize = sizeof(float)
+        buffer.format = "f" if flags & PyBUF_FORMAT else NULL
+        buffer.ndim = 1
+        buffer.shape = self._shape if flags & PyBUF_ND else NULL
+        buffer.strides = self._strides if (flags & PyBUF_STRIDES) == PyBUF_STRIDES else NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+        self._exports += 1
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        self._exports -= 1
+
+    def to_list(self):
+        return Float32Value.vector_of_floats_to_list(
+            &((<cFloat32Value*>self.get_c_raw_ptr()).value()))
+
+    @staticmethod
+    cdef vector[float] list_of_floats_to_vector(list python_list):
+        cdef vector[float] cpp_vector
+        cdef float value
+        for value in python_list:
+            cpp_vector.push_back(value)
+        return cpp_vector
+
+    @staticmethod
+    cdef list vector_of_floats_to_list(const vector[float]* cpp_vector):
+        list = []
+        it = cpp_vector.const_begin()
+        while it != cpp_vector.const_end():
+            list.append(deref(it))
+            inc(it)
+        return list
@@ -1,5 +1,6 @@
-
 def createFloatValue(arg):
+    if PyObject_CheckBuffer(arg):
+        return FloatValue.from_buffer(arg)
     cdef shared_ptr[cFloatValue] c_ptr
     if (isinstance(arg, list)):
         c_ptr = c_createFloatValue_vector(FloatValue.list_of_doubles_to_vector(arg))
@@ -10,17 +11,83 @@ def createFloatValue(arg):
     return instance
 
 cdef class FloatValue(Value):
+    """A vector of doubles.
+
+    FloatValues support the buffer protocol, so that they can be viewed
+    without copying, e.g. with `memoryview(fv)` or `numpy.asarray(fv)`.
+    The view is read-only, as Values are immutable. Likewise, anything
+    that exports a contiguous buffer of doubles, such as a numpy float64
+    array, can be passed to the constructor; it is copied in one block.
+    """
+
+    # Streaming values, such as RandomStream, hand out new numbers on
+    # every read. Buffers given out for these point at a snapshot, which
+    # is kept for as long as any of them are still in use.
+    cdef vector[double] _snapshot
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+    cdef int _exports
 
     def __init__(self, arg=None):
         # Allow construction with argument: FloatValue([1.0, 2.0]) or FloatValue(1.0)
         # If arg is None, assume we're being created via __new__ from createFloatValue
         cdef shared_ptr[cFloatValue] c_ptr
         if arg is not None:
-            if isinstance(arg, list):
+            if PyObject_CheckBuffer(arg):
+                self.shared_ptr = FloatValue.buffer_to_value(arg)
+            elif isinstance(arg, list):
                 c_ptr = c_createFloatValue_vector(FloatValue.list_of_doubles_to_vector(arg))
+                self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
             else:
                 c_ptr = c_createFloatValue_single(<double>arg)
-            self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
+                self.shared_ptr = <cValuePtr&>(c_ptr, c_ptr.get())
+
+    @staticmethod
+    def from_buffer(obj):
+        """Create a FloatValue from anything that exports a contiguous
+        buffer of doubles."""
+        cdef FloatValue instance = FloatValue.__new__(FloatValue)
+        instance.shared_ptr = FloatValue.buffer_to_value(obj)
+        return instance
+
+    @staticmethod
+    cdef cValuePtr buffer_to_value(obj):
+        cdef const double[::1] view = obj
+        cdef size_t n = view.shape[0]
+        if 0 == n:
+            return c_float_value_from_buffer(NULL, 0)
+        return c_float_value_from_buffer(&view[0], n)
+
+    def __getbuffer__(self, Py_buffer* buffer, int flags):
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("FloatValue is immutable")
+        if self.get_c_raw_ptr() == NULL:
+            raise BufferError("FloatValue is empty")
+
+        cdef const vector[double]* vp = \
+            &((<cFloatValue*>self.get_c_raw_ptr()).value())
+        if self.type != types.FloatValue:
+            if 0 == self._exports:
+                self._snapshot = deref(vp)
+            vp = &self._snapshot
+
+        self._shape[0] = vp.size()
+        self._strides[0] = sizeof(double)
+        buffer.buf = <void*> vp.data()
+        buffer.obj = self
+        buffer.len = vp.size() * sizeof(double)
+        buffer.readonly = 1
+        buffer.itemsize = sizeof(double)
+        buffer.format = "d" if flags & PyBUF_FORMAT else NULL
+        buffer.ndim = 1
+        buffer.shape = self._shape if flags & PyBUF_ND else NULL
+        buffer.strides = self._strides if (flags & PyBUF_STRIDES) == PyBUF_STRIDES else NULL
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+        self._exports += 1
+
+    def __releasebuffer__(self, Py_buffer* buffer):
+        self._exports -= 1
 
     def to_list(self):
         return FloatValue.vector_of_doubles_to_list(
@@ -151,6 +151,8 @@ cdef create_python_value_from_c_value(const cValuePtr& value):
         py_class_ctor = LinkValue
     elif is_a(value_type, types.FloatValue):
         py_class_ctor = FloatValue
+    elif is_a(value_type, types.Float32Value):
+        py_class_ctor = Float32Value
     elif is_a(value_type, types.StringValue):
         py_class_ctor = StringValue
     elif is_a(value_type, types.BoolValue):
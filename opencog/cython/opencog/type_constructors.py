@@ -29,7 +29,7 @@ from opencog.atomspace import *
 # Value wrapper functions - these provide convenience constructors
 # that shadow the class names. In atomspace, use createBoolValue etc.
 from opencog.atomspace import (
-    createBoolValue, createFloatValue, createLinkValue,
+    createBoolValue, createFloatValue, createFloat32Value, createLinkValue,
     createQueueValue, createStringValue, createUnisetValue, createVoidValue
 )
 
@@ -39,6 +39,9 @@ def BoolValue(arg):
 def FloatValue(arg):
     return createFloatValue(arg)
 
+def Float32Value(arg):
+    return createFloat32Value(arg)
+
 def LinkValue(arg):
     return createLinkValue(arg)
 
@@ -58,7 +61,7 @@ def VoidValue():
 try:
     from opencog.atomspace import __all__ as _atomspace_all
     __all__ = list(_atomspace_all) + [
-        'BoolValue', 'FloatValue', 'LinkValue', 'QueueValue',
+        'BoolValue', 'FloatValue', 'Float32Value', 'LinkValue', 'QueueValue',
         'StringValue', 'UnisetValue', 'VoidValue'
     ]
 except ImportError:
@@ -1,5 +1,33 @@
 from cpython.object cimport Py_EQ, Py_NE
+from cpython.buffer cimport PyObject_CheckBuffer, PyBUF_WRITABLE, \
+    PyBUF_FORMAT, PyBUF_ND, PyBUF_STRIDES
+from cpython.pycapsule cimport PyCapsule_New, PyCapsule_GetPointer
+from libc.stdlib cimport malloc, free
 from cython.operator cimport dereference as deref, preincrement as inc
+from libc.stdint cimport uint64_t
+
+# Bulk constructors for the vector Values; these are used by the
+# buffer-protocol support in FloatValue, Float32Value and BoolValue.
+cdef extern from "opencog/cython/opencog/ValueBuffers.h" namespace "opencog":
+    cValuePtr c_float_value_from_buffer "opencog::float_value_from_buffer" (const double*, size_t) nogil
+    cValuePtr c_float32_value_from_buffer "opencog::float32_value_from_buffer" (const float*, size_t) nogil
+    cValuePtr c_bool_value_from_words "opencog::bool_value_from_words" (const uint64_t*, size_t) nogil
+
+
+# Destructors for the Arrow PyCapsules. Whoever imports the data
+# will have moved it out, and marked it released; if nobody did,
+# it is released here.
+cdef void arrow_schema_capsule_free(object capsule) noexcept:
+    cdef ArrowSchema* sch = <ArrowSchema*> PyCapsule_GetPointer(capsule, "arrow_schema")
+    if sch.release != NULL:
+        sch.release(sch)
+    free(sch)
+
+cdef void arrow_array_capsule_free(object capsule) noexcept:
+    cdef ArrowArray* arr = <ArrowArray*> PyCapsule_GetPointer(capsule, "arrow_array")
+    if arr.release != NULL:
+        arr.release(arr)
+    free(arr)
 
 
 cdef class Value:
@@ -62,6 +90,21 @@ cdef class Value:
     def __iter__(self):
         return self.to_list().__iter__()
 
+    def __arrow_c_array__(self, requested_schema=None):
+        """Arrow PyCapsule interface, so that e.g. `pyarrow.array(v)`
+        can import FloatValues, StringValues and LinkValues of columns.
+        FloatValue data is shared, not copied."""
+        cdef ArrowSchema* sch = <ArrowSchema*> malloc(sizeof(ArrowSchema))
+        cdef ArrowArray* arr = <ArrowArray*> malloc(sizeof(ArrowArray))
+        sch.release = NULL
+        arr.release = NULL
+        schema_capsule = PyCapsule_New(sch, "arrow_schema",
+                                       arrow_schema_capsule_free)
+        array_capsule = PyCapsule_New(arr, "arrow_array",
+                                      arrow_array_capsule_free)
+        c_arrow_export(self.shared_ptr, arr, sch)
+        return (schema_capsule, array_capsule)
+
     def long_string(self):
         return self.get_c_raw_ptr().to_string().decode('UTF-8')
 
@@ -14,6 +14,14 @@ cdef class FloatValue(Value):
     cdef list vector_of_doubles_to_list(const vector[double]* cpp_vector)
 
 
+cdef class Float32Value(Value):
+    @staticmethod
+    cdef vector[float] list_of_floats_to_vector(list python_list)
+
+    @staticmethod
+    cdef list vector_of_floats_to_list(const vector[float]* cpp_vector)
+
+
 cdef class StringValue(Value):
     @staticmethod
     cdef vector[string] list_of_strings_to_vector(list python_list)
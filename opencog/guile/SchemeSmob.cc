@@ -324,6 +324,7 @@ void SchemeSmob::register_procs()
 	register_proc("cog-pop-atomspace",     0, 0, 0, C(ss_pop_atomspace));
 	register_proc("cog-atomspace-env",     0, 1, 0, C(ss_as_env));
 	register_proc("cog-atomspace-clear",   0, 1, 0, C(ss_as_clear));
+	register_proc("cog-atomspace-squash",  2, 1, 0, C(ss_as_squash));
 	register_proc("cog-atomspace-readonly?", 0, 1, 0, C(ss_as_readonly_p));
 	register_proc("cog-atomspace-ro!",     0, 1, 0, C(ss_as_mark_readonly));
 	register_proc("cog-atomspace-rw!",     0, 1, 0, C(ss_as_mark_readwrite));
@@ -147,6 +147,7 @@ private:
 	static SCM ss_pop_atomspace(void);
 	static SCM ss_as_env(SCM);
 	static SCM ss_as_clear(SCM);
+	static SCM ss_as_squash(SCM, SCM, SCM);
 	static SCM ss_as_mark_readonly(SCM);
 	static SCM ss_as_mark_readwrite(SCM);
 	static SCM ss_as_readonly_p(SCM);
@@ -251,6 +251,33 @@ SCM SchemeSmob::ss_as_clear(SCM sas)
 	return SCM_BOOL_T;
 }
 
+/* ============================================================== */
+/**
+ * Squash a run of frames into one. See AtomSpace::squash() for the
+ * details. Returns the new copy of the atomspace; if no atomspace is
+ * specified, then the current atomspace is squashed.
+ */
+SCM SchemeSmob::ss_as_squash(SCM sbottom, SCM stop, SCM sas)
+{
+	AtomSpace* bottom = verify_atomspace(sbottom, "cog-atomspace-squash", 1);
+	AtomSpace* top = verify_atomspace(stop, "cog-atomspace-squash", 2);
+	const AtomSpacePtr& asg = ss_to_atomspace(sas);
+	const AtomSpacePtr& asp = asg ? asg :
+		ss_get_env_as("cog-atomspace-squash");
+
+	AtomSpacePtr squashed;
+	try
+	{
+		squashed = asp->squash(bottom, top);
+	}
+	catch (const std::exception& ex)
+	{
+		throw_exception(ex, "cog-atomspace-squash", scm_list_2(sbottom, stop));
+	}
+	scm_remember_upto_here_1(sas);
+	return make_as(squashed);
+}
+
 /* ============================================================== */
 /**
  * Return the atomspace of an atom.
@@ -0,0 +1,153 @@
+/*
+ * opencog/query/GroundingCache.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Clause groundings that are kept from one search to the next.
+ */
+
+#include <algorithm>
+#include <mutex>
+
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/atomspace/TypeIndex.h>
+
+#include "GroundingCache.h"
+
+using namespace opencog;
+
+static void link_types(const Handle& h, std::vector<Type>& types)
+{
+	if (not h->is_link()) return;
+	types.push_back(h->get_type());
+	for (const Handle& ho : h->getOutgoingSet())
+		link_types(ho, types);
+}
+
+GroundingCache::GroundingCache(const Pattern& pat, size_t max_entries) :
+	_as(nullptr), _ticket(0)
+{
+	for (const Handle& clause : pat.cacheable_clauses)
+	{
+		std::vector<Type> types;
+		link_types(clause, types);
+
+		// A clause that is a lone variable is grounded by any Atom
+		// at all; there's no telling which changes would matter.
+		if (types.empty()) continue;
+
+		std::sort(types.begin(), types.end());
+		types.erase(std::unique(types.begin(), types.end()), types.end());
+		for (Type t : types)
+			TypeIndex::watch_type(t);
+
+		_clauses[clause].types = std::move(types);
+	}
+
+	size_t ncl = std::max((size_t) 1, _clauses.size());
+	_gen_size = std::max((size_t) 1, max_entries / (2 * ncl));
+}
+
+/// Changes that affect all types count for every clause.
+uint64_t GroundingCache::count_changes(const std::vector<Type>& types)
+{
+	uint64_t n = TypeIndex::changes(NOTYPE);
+	for (Type t : types)
+		n += TypeIndex::changes(t);
+	return n;
+}
+
+uint64_t GroundingCache::refresh(AtomSpace* as)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+
+	// A new AtomSpace may have been created where an old one was.
+	bool same_as = (as == _as and not _as_alive.expired());
+	bool dropped = not same_as;
+	for (auto& pr : _clauses)
+	{
+		ClauseCache& cc = pr.second;
+		uint64_t n = count_changes(cc.types);
+		if (same_as and n == cc.changes) continue;
+		if (0 < cc.cur.size() or 0 < cc.old.size())
+		{
+			cc.cur.clear();
+			cc.old.clear();
+			dropped = true;
+		}
+		cc.changes = n;
+	}
+
+	if (dropped) _ticket++;
+	_as = as;
+	_as_alive = as->weak_from_this();
+	return _ticket;
+}
+
+void GroundingCache::put(ClauseCache& cc, const HandleSeq& key,
+                         const Handle& gnd)
+{
+	if (_gen_size <= cc.cur.size())
+	{
+		cc.old.swap(cc.cur);
+		cc.cur.clear();
+	}
+	cc.cur[key] = gnd;
+}
+
+Handle GroundingCache::lookup(const HandleSeq& key)
+{
+	Handle gnd;
+	{
+		std::shared_lock<std::shared_mutex> lck(_mtx);
+		const auto& cit = _clauses.find(key[0]);
+		if (_clauses.end() == cit) return Handle::UNDEFINED;
+
+		const ClauseCache& cc = cit->second;
+		const auto& it = cc.cur.find(key);
+		if (cc.cur.end() != it) return it->second;
+
+		const auto& oit = cc.old.find(key);
+		if (cc.old.end() == oit) return Handle::UNDEFINED;
+		gnd = oit->second;
+	}
+
+	// Found in the old generation; move it to the current one.
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	ClauseCache& cc = _clauses[key[0]];
+	if (0 < cc.old.erase(key))
+		put(cc, key, gnd);
+	return gnd;
+}
+
+void GroundingCache::insert(uint64_t ticket, const HandleSeq& key,
+                            const Handle& gnd)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	if (ticket != _ticket) return;
+
+	const auto& cit = _clauses.find(key[0]);
+	if (_clauses.end() == cit) return;
+	put(cit->second, key, gnd);
+}
+
+size_t GroundingCache::size(void) const
+{
+	std::shared_lock<std::shared_mutex> lck(_mtx);
+	size_t cnt = 0;
+	for (const auto& pr : _clauses)
+		cnt += pr.second.cur.size() + pr.second.old.size();
+	return cnt;
+}
+
+void GroundingCache::clear(void)
+{
+	std::unique_lock<std::shared_mutex> lck(_mtx);
+	for (auto& pr : _clauses)
+	{
+		pr.second.cur.clear();
+		pr.second.old.clear();
+	}
+	_ticket++;
+}
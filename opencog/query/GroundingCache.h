@@ -0,0 +1,101 @@
+/*
+ * opencog/query/GroundingCache.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Clause groundings that are kept from one search to the next.
+ */
+
+#ifndef _OPENCOG_GROUNDING_CACHE_H
+#define _OPENCOG_GROUNDING_CACHE_H
+
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <opencog/atoms/base/Atom.h>
+#include <opencog/atoms/pattern/Pattern.h>
+
+namespace opencog
+{
+class AtomSpace;
+
+/**
+ * GroundingCache - remembers how the cacheable clauses of a pattern
+ * were grounded, so that later searches with the same pattern can
+ * skip re-grounding them. It is hung off of the PatternLink; see
+ * `PatternLink::set_grounding_cache()`. The PatternMatchEngine has
+ * its own, per-search caches; this is a second level, under those.
+ *
+ * The key is the same as for the engine's cache: the clause, followed
+ * by the groundings of the variables in it. Given those, a cacheable
+ * clause can be grounded in only one way, so the grounding stays good
+ * for as long as the AtomSpace does not change. Only successful
+ * groundings are kept; the engine's negative cache only records
+ * what was already explored during one search, and is not a fact
+ * about the AtomSpace.
+ *
+ * Stale groundings are dropped by `refresh()`, at the start of each
+ * search: the groundings of a clause are dropped when any Atom of a
+ * Link type appearing in that clause has been added or removed (see
+ * `TypeIndex::changed()`), or when the search is in a different
+ * AtomSpace than the last one.
+ *
+ * The size is bounded by keeping two generations per clause. New
+ * groundings go into the current one; when it is full, the old one
+ * is dropped, and the current one becomes the old one. Groundings
+ * found in the old one are moved back to the current one.
+ *
+ * Thread-safe; the workers of a parallel search all share one cache.
+ */
+class GroundingCache
+{
+public:
+	/// Keep no more than `max_entries` groundings for the clauses
+	/// of `pat`.
+	GroundingCache(const Pattern& pat, size_t max_entries);
+
+	/// Call at the start of each search in AtomSpace `as`. Drops
+	/// groundings that may have gone stale since the last search.
+	/// Returns a ticket, to be passed to `insert()`.
+	uint64_t refresh(AtomSpace* as);
+
+	/// Return the grounding of the clause `key[0]`, given the variable
+	/// groundings in the rest of the key; or the undefined handle.
+	Handle lookup(const HandleSeq& key);
+
+	/// Record a grounding. Ignored if the cache was refreshed, and
+	/// had groundings dropped, after `ticket` was handed out.
+	void insert(uint64_t ticket, const HandleSeq& key, const Handle& gnd);
+
+	size_t size(void) const;
+	void clear(void);
+
+private:
+	typedef std::unordered_map<HandleSeq, Handle> GroundMap;
+
+	struct ClauseCache
+	{
+		std::vector<Type> types;  // Link types in the clause.
+		uint64_t changes = 0;     // Their change counts, when last checked.
+		GroundMap cur;
+		GroundMap old;
+	};
+
+	mutable std::shared_mutex _mtx;
+	std::unordered_map<Handle, ClauseCache> _clauses;
+	size_t _gen_size;
+	const AtomSpace* _as;
+	std::weak_ptr<Value> _as_alive;
+	uint64_t _ticket;
+
+	static uint64_t count_changes(const std::vector<Type>&);
+	void put(ClauseCache&, const HandleSeq&, const Handle&);
+};
+
+typedef std::shared_ptr<GroundingCache> GroundingCachePtr;
+
+} // namespace opencog
+
+#endif // _OPENCOG_GROUNDING_CACHE_H
@@ -51,6 +51,10 @@ class Implicator:
 				RewriteMixin::set_pattern(vars, pat);
 			}
 
+			// The rewriting is done under a lock, and the term
+			// matching keeps its state per-thread.
+			virtual bool is_thread_safe(void) { return true; }
+
 			virtual bool satisfy(const PatternLinkPtr& plp)
 			{
 				RewriteMixin::set_plp(plp);
@@ -21,6 +21,12 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <thread>
+
 #include <opencog/atomspace/AtomSpace.h>
 
 #include <opencog/atoms/grant/DefineLink.h>
@@ -31,12 +37,7 @@
 
 #include "InitiateSearchMixin.h"
 #include "PatternMatchEngine.h"
-
-#ifdef USE_THREADED_PATTERN_ENGINE
-	// #include <algorithm>
-	// #include <execution>
-	#include <opencog/util/oc_omp.h>
-#endif // USE_THREADED_PATTERN_ENGINE
+#include "SearchPool.h"
 
 using namespace opencog;
 
@@ -54,7 +55,6 @@ InitiateSearchMixin::InitiateSearchMixin(AtomSpace* as) :
 {
 	_variables = nullptr;
 	_pattern = nullptr;
-	_recursing = false;
 
 	_root = PatternTerm::UNDEFINED;
 	_starter_term = PatternTerm::UNDEFINED;
@@ -66,6 +66,44 @@ InitiateSearchMixin::InitiateSearchMixin(AtomSpace* as) :
 
 /* ======================================================== */
 
+// The number of Links that a search starting at the constant `h`
+// would have to look at: those in the incoming set of `h` that have
+// the same type as the term holding it.
+static size_t start_width(const Handle& h, const PatternTermPtr& startrm)
+{
+	if (nullptr == startrm or nullptr == startrm->getHandle())
+		return h->getIncomingSetSize();
+	return h->getIncomingSetSizeByType(startrm->getHandle()->get_type());
+}
+
+/// Estimate the cost of a search that starts with `width` candidates
+/// for the term `start`. Each candidate is looked at; and from each
+/// one, the matcher climbs up to the top of the clause, and then goes
+/// on to the rest of the pattern from every grounding of the clause
+/// that it finds. The number of such groundings is estimated from
+/// the incoming-set statistics, for each step of the climb.
+double InitiateSearchMixin::start_cost(const PatternTermPtr& start,
+                                       double width) const
+{
+	if (0.0 == width) return 0.0;
+
+	const AtomStats& stats = _as->get_stats();
+	double climb = 1.0;
+	PatternTermPtr term(start);
+	PatternTermPtr parent(term->getParent());
+	while (nullptr != parent and nullptr != parent->getHandle())
+	{
+		climb *= stats.incoming(term->getHandle()->get_type(),
+		                        parent->getHandle()->get_type()).mean;
+		if (0.0 == climb) break;
+		term = parent;
+		parent = term->getParent();
+	}
+	return width * (1.0 + climb);
+}
+
+/* ======================================================== */
+
 // Find a good place to start the search.
 //
 // The handle h points to a clause.  In principle, it is enough to
@@ -106,7 +144,9 @@ InitiateSearchMixin::InitiateSearchMixin(AtomSpace* as) :
 // size_t& depth will be set to the depth of the thinnest constant found.
 // Handle& start will be set to the link containing that constant.
 // size_t& width will be set to the incoming-set size of the thinnest
-//               constant found.
+//               constant found. Only the Links of the same type as
+//               the start term are counted, since only those are
+//               searched.
 // The returned value will be the constant at which to start the search.
 // If no constant is found, then the returned value is the undefined
 // handle.
@@ -155,7 +195,7 @@ InitiateSearchMixin::find_starter_recursive(const PatternTermPtr& ptm,
 	{
 		if (VARIABLE_NODE != t and GLOB_NODE != t and SIGN_NODE != t)
 		{
-			width = h->getIncomingSetSize();
+			width = start_width(h, startrm);
 			return h;
 		}
 		return Handle::UNDEFINED;
@@ -229,6 +269,10 @@ InitiateSearchMixin::find_starter_recursive(const PatternTermPtr& ptm,
  * Skip any/all evaluatable clauses, as these typically do not
  * exist in the atomspace, anyway.
  *
+ * The thinnest clause is the one with the cheapest start, as given by
+ * `start_cost()`: a narrow start deep inside a clause can still be a
+ * poor choice, if every step up to the top of the clause fans out.
+ *
  * An exception: the IdenticalLink can be treated as non-virtual, and we
  * can begin the search at ne of the terms inside of an IdenticalLink.
  */
@@ -236,12 +280,13 @@ Handle InitiateSearchMixin::find_thinnest(const PatternTermSeq& clauses,
                                           PatternTermPtr& starter_term,
                                           PatternTermPtr& bestclause)
 {
-	size_t thinnest = SIZE_MAX;
+	double cheapest = INFINITY;
 	size_t deepest = 0;
 	bestclause = PatternTerm::UNDEFINED;
 	Handle best_start(Handle::UNDEFINED);
 	starter_term = PatternTerm::UNDEFINED;
 	_start_choices.clear();
+	_next_plan.considered.clear();
 
 	for (const PatternTermPtr& ptm: clauses)
 	{
@@ -253,15 +298,26 @@ Handle InitiateSearchMixin::find_thinnest(const PatternTermSeq& clauses,
 		size_t width = SIZE_MAX;
 		PatternTermPtr term(PatternTerm::UNDEFINED);
 		Handle start(find_starter(ptm, depth, term, width));
-		if (start
-		    and (width < thinnest
-		         or (width == thinnest and depth > deepest)))
+		if (start)
 		{
-			thinnest = width;
-			deepest = depth;
-			bestclause = ptm;
-			best_start = start;
-			starter_term = term;
+			Option opt;
+			opt.clause = ptm;
+			opt.start_term = term;
+			opt.estimate = width;
+			opt.cost = start_cost(term, width);
+			_next_plan.considered.push_back(opt);
+
+			if (opt.cost < cheapest
+			    or (opt.cost == cheapest and depth > deepest))
+			{
+				cheapest = opt.cost;
+				deepest = depth;
+				bestclause = ptm;
+				best_start = start;
+				starter_term = term;
+				_next_plan.estimate = opt.estimate;
+				_next_plan.cost = opt.cost;
+			}
 		}
 
 		// If we encountered choices, then we have enumerated all of them.
@@ -275,6 +331,28 @@ Handle InitiateSearchMixin::find_thinnest(const PatternTermSeq& clauses,
 
 /* ======================================================== */
 
+/// If the ordered, glob-free `term` holds `start` as a direct child,
+/// in exactly one place, then return true, and that place in `pos`.
+/// Links that hold `start` anywhere else cannot match `term`.
+static bool start_position(const PatternTermPtr& term,
+                           const Handle& start, Arity& pos)
+{
+	const Handle& lnk(term->getHandle());
+	if (lnk->is_unordered_link() or term->hasGlobbyVar())
+		return false;
+
+	bool found = false;
+	Arity sz = lnk->get_arity();
+	for (Arity i = 0; i < sz; i++)
+	{
+		if (lnk->getOutgoingAtom(i) != start) continue;
+		if (found) return false;
+		found = true;
+		pos = i;
+	}
+	return found;
+}
+
 const PatternTermSeq& InitiateSearchMixin::get_clause_list(void)
 {
 	// Sometimes, the number of mandatory clauses can be zero...
@@ -363,11 +441,19 @@ bool InitiateSearchMixin::setup_neighbor_search(const PatternTermSeq& clauses)
 		ch.start_term = _starter_term;
 
 		// This feels wonky. Is this correct?
-		if (_starter_term->getHandle()->is_link())
+		const Handle& starter(_starter_term->getHandle());
+		if (starter->is_link())
 		{
 			// XXX ?? Why incoming set ???
-			ch.search_set = get_incoming_set(best_start,
-			                              _starter_term->getHandle()->get_type());
+			// If the starter holds the start in just one place, then
+			// only those links holding it in that same place can match.
+			Arity pos = 0;
+			if (start_position(_starter_term, best_start, pos))
+				ch.search_set = get_incoming_by_position(best_start,
+				         starter->get_type(), starter->get_arity(), pos);
+			else
+				ch.search_set = get_incoming_set(best_start,
+				                                 starter->get_type());
 		}
 		else
 		{
@@ -379,6 +465,7 @@ bool InitiateSearchMixin::setup_neighbor_search(const PatternTermSeq& clauses)
 	{
 		// TODO -- weed out duplicates!
 	}
+	_next_plan.strategy = "neighbor search";
 	return true;
 }
 
@@ -393,6 +480,13 @@ bool InitiateSearchMixin::choice_loop(PatternMatchCallback& pmc,
 		_starter_term = ch.start_term;
 		_search_set = ch.search_set;
 
+		// Each choice is a search of its own.
+		if (1 < _start_choices.size())
+		{
+			_next_plan.estimate = _search_set.size();
+			_next_plan.cost = start_cost(_starter_term, _search_set.size());
+		}
+
 		DO_LOG({LAZY_LOG_FINE << "Choice loop start term is:\n"
 		              << (_starter_term->to_short_string("       "));})
 		DO_LOG({LAZY_LOG_FINE << "Choice loop root clause is:\n"
@@ -506,6 +600,7 @@ bool InitiateSearchMixin::perform_search(PatternMatchCallback& pmc)
 	_curr_clause = PatternTerm::UNDEFINED;
 	_search_set.clear();
 	_start_choices.clear();
+	_next_plan = Plan();
 
 	// Fallback to the legacy mode.
 	if (1 != _pattern->pmandatory.size())
@@ -584,6 +679,8 @@ bool InitiateSearchMixin::legacy_search(PatternMatchCallback& pmc)
 	DO_LOG({logger().fine("Cannot use node-neighbor search, use no-var search");})
 	if (setup_no_search())
 	{
+		_next_plan.strategy = "no search";
+		record_plan(0);
 		PatternMatchEngine pme(pmc);
 		pme.set_pattern(*_variables, *_pattern);
 		return pme.explore_constant_evaluatables(_pattern->pmandatory);
@@ -616,13 +713,64 @@ bool InitiateSearchMixin::legacy_search(PatternMatchCallback& pmc)
 }
 
 /* ======================================================== */
+/**
+ * Estimate the cost of a search that starts with all of the Links of
+ * the same type as `term`. Every one of them has to be looked at; but
+ * only those with the right kinds of Atoms in them go any further.
+ * The fraction that do is estimated from the outgoing-set statistics,
+ * one position at a time, using the type restrictions on variables.
+ */
+double InitiateSearchMixin::link_cost(const PatternTermPtr& term) const
+{
+	const AtomStats& stats = _as->get_stats();
+	Type t = term->getHandle()->get_type();
+	double num = stats.count(t);
+	if (0.0 == num) return 0.0;
+
+	// The positions in unordered links are meaningless.
+	double pass = 1.0;
+	if (not term->isUnorderedLink())
+	{
+		const PatternTermSeq& oset = term->getOutgoingSet();
+		for (size_t i = 0; i < oset.size(); i++)
+		{
+			const PatternTermPtr& sub = oset[i];
+
+			// Globs shift everything after them.
+			if (sub->isGlobbyVar()) break;
+
+			// These match more than one type; don't guess.
+			if (sub->isAnonVar() or sub->isChoice() or
+			    sub->hasAnyEvaluatable()) continue;
+
+			const Handle& h = sub->getHandle();
+			if (not sub->isBoundVariable())
+			{
+				pass *= stats.share(t, i, h->get_type());
+				continue;
+			}
+
+			const auto& tit = _variables->_typemap.find(h);
+			if (_variables->_typemap.end() == tit) continue;
+			const TypeSet& typeset = tit->second->get_simple_typeset();
+			if (typeset.empty()) continue;
+
+			double frac = 0.0;
+			for (Type vt : typeset)
+				frac += stats.share(t, i, vt);
+			pass *= std::min(frac, 1.0);
+		}
+	}
+	return num * (1.0 + pass);
+}
+
 /**
  * Find the rarest link type contained in the clause, or one
- * of its subclauses.
+ * of its subclauses. Rarest means cheapest, as given by `link_cost()`.
  */
 void InitiateSearchMixin::find_rarest(const PatternTermPtr& clause,
                                       PatternTermPtr& rarest,
-                                      size_t& count,
+                                      double& cost,
                                       Quotation quotation)
 {
 	if (not clause->isLink()) return;
@@ -636,10 +784,10 @@ void InitiateSearchMixin::find_rarest(const PatternTermPtr& clause,
 	Type t = clause->getHandle()->get_type();
 	if (not quotation.consumable(t))
 	{
-		size_t num = (size_t) _as->get_num_atoms_of_type(t);
-		if (num < count)
+		double num = link_cost(clause);
+		if (num < cost)
 		{
-			count = num;
+			cost = num;
 			rarest = clause;
 		}
 	}
@@ -649,7 +797,7 @@ void InitiateSearchMixin::find_rarest(const PatternTermPtr& clause,
 
 	const PatternTermSeq& oset = clause->getOutgoingSet();
 	for (const PatternTermPtr& ptm : oset)
-		find_rarest(ptm, rarest, count, quotation);
+		find_rarest(ptm, rarest, cost, quotation);
 }
 
 /* ======================================================== */
@@ -837,7 +985,13 @@ bool InitiateSearchMixin::setup_deep_type_search(const PatternTermSeq& clauses)
 
 		// We only need enough startng points to get started;
 		// the matcher will crawl the rest of the graph.
-		if (0 < _search_set.size()) return true;
+		if (0 < _search_set.size())
+		{
+			_next_plan.strategy = "deep-type search";
+			_next_plan.estimate = _search_set.size();
+			_next_plan.cost = start_cost(_starter_term, _search_set.size());
+			return true;
+		}
 	}
 
 	// Do it again...
@@ -867,7 +1021,13 @@ bool InitiateSearchMixin::setup_deep_type_search(const PatternTermSeq& clauses)
 		_root = root;
 		_starter_term = term_of_handle(var, root);
 		_as->get_handles_by_type(_search_set, t);
-		if (0 < _search_set.size()) return true;
+		if (0 < _search_set.size())
+		{
+			_next_plan.strategy = "deep-type search";
+			_next_plan.estimate = _search_set.size();
+			_next_plan.cost = start_cost(_starter_term, _search_set.size());
+			return true;
+		}
 	}
 
 	return false;
@@ -879,7 +1039,8 @@ bool InitiateSearchMixin::setup_deep_type_search(const PatternTermSeq& clauses)
  * Links of the same type as one of the links in the set of clauses.
  * This attempts to minimize the search space by picking the link type
  * which has the smallest number of atoms of that type in the
- * AtomSpace.
+ * AtomSpace, after weighing in how many of those would be rejected
+ * right away (see `link_cost()`).
  *
  * The list of starting points is placed into `_search_set` and this
  * method returns true. If it cannot find any starting points, this
@@ -889,7 +1050,8 @@ bool InitiateSearchMixin::setup_link_type_search(const PatternTermSeq& clauses)
 {
 	_root = PatternTerm::UNDEFINED;
 	_starter_term = PatternTerm::UNDEFINED;
-	size_t count = SIZE_MAX;
+	_next_plan.considered.clear();
+	double cost = INFINITY;
 
 	for (const PatternTermPtr& cl: clauses)
 	{
@@ -897,11 +1059,22 @@ bool InitiateSearchMixin::setup_link_type_search(const PatternTermSeq& clauses)
 		// Cannot start a search with them.
 		if (cl->hasAnyEvaluatable()) continue;
 
-		const size_t prev = count;
-		find_rarest(cl, _starter_term, count);
-		if (count < prev)
+		Option opt;
+		opt.clause = cl;
+		opt.cost = INFINITY;
+		find_rarest(cl, opt.start_term, opt.cost);
+		if (nullptr == opt.start_term) continue;
+
+		opt.estimate = _as->get_stats().count(
+			opt.start_term->getHandle()->get_type());
+		_next_plan.considered.push_back(opt);
+		if (opt.cost < cost)
 		{
+			cost = opt.cost;
 			_root = cl;
+			_starter_term = opt.start_term;
+			_next_plan.estimate = opt.estimate;
+			_next_plan.cost = opt.cost;
 		}
 	}
 
@@ -923,6 +1096,7 @@ bool InitiateSearchMixin::setup_link_type_search(const PatternTermSeq& clauses)
 	Type ptype = _starter_term->getHandle()->get_type();
 
 	_as->get_handles_by_type(_search_set, ptype);
+	_next_plan.strategy = "link-type search";
 	return true;
 }
 
@@ -976,10 +1150,12 @@ bool InitiateSearchMixin::setup_variable_search(const PatternTermSeq& clauses)
 		DO_LOG({LAZY_LOG_FINE << "Type-restriction set size = "
 		                      << typeset.size();})
 
-		// Calculate the total number of atoms of typeset
+		// Estimate the total number of atoms of typeset. An exact
+		// count is not needed, and can be slow to get, in deep stacks
+		// of AtomSpaces. The estimate is zero only if there are none.
 		size_t num = 0;
 		for (Type t : typeset)
-			num += (size_t) _as->get_num_atoms_of_type(t);
+			num += _as->get_stats().count(t);
 
 		DO_LOG({LAZY_LOG_FINE << var->to_short_string() << " has "
 		                      << num << " atoms in the atomspace";})
@@ -1067,6 +1243,10 @@ bool InitiateSearchMixin::setup_variable_search(const PatternTermSeq& clauses)
 		for (Type ptype : ptypes)
 			_as->get_handles_by_type(_search_set, ptype);
 
+	_next_plan.strategy = "variable search";
+	_next_plan.estimate = ptypes.empty() ?
+		_as->get_stats().count(ATOM, true) : count;
+	_next_plan.cost = _next_plan.estimate;
 	return true;
 }
 
@@ -1089,6 +1269,52 @@ bool InitiateSearchMixin::setup_no_search(void)
 
 /* ======================================================== */
 
+// Tuning knobs for the parallel search loop. See `search_workers()`.
+static std::atomic<size_t> parallel_cutover(2048);
+static std::atomic<size_t> max_search_threads(
+	std::max(1U, std::thread::hardware_concurrency()));
+
+void InitiateSearchMixin::set_parallel_cutover(size_t cutover)
+{
+	parallel_cutover = cutover;
+}
+
+void InitiateSearchMixin::set_max_search_threads(size_t nthreads)
+{
+	max_search_threads = nthreads;
+}
+
+/// search_workers() -- decide how many threads to use for the search.
+///
+/// Going parallel is not free: the workers have to be woken up, and
+/// each one needs its own PatternMatchEngine and traversal state. For
+/// the typical small search, this costs far more than it saves. (An
+/// earlier experiment that started fresh threads for every search
+/// made RandomUTest run 25x slower, and GetStateUTest 33x slower!)
+/// So the decision is made adaptively: the amount of work is estimated
+/// from the number of starting points, and the size of the pattern;
+/// one more thread is added for every `parallel_cutover` units of work.
+/// Returns 1 if the search should be run sequentially.
+size_t InitiateSearchMixin::search_workers(PatternMatchCallback& pmc)
+{
+	size_t maxthr = max_search_threads;
+	if (maxthr < 2) return 1;
+	if (not pmc.is_thread_safe()) return 1;
+
+	// Queries run from within a parallel search run sequentially.
+	if (SearchPool::in_worker()) return 1;
+
+	// Evaluatable clauses typically run scheme or python code, or
+	// at least perform arithmetic; weight them as being expensive.
+	size_t cost = 1 + _pattern->pmandatory.size()
+		+ _pattern->absents.size() + _pattern->always.size();
+	if (_pattern->have_evaluatables) cost *= 8;
+
+	size_t cutover = std::max((size_t) 1, (size_t) parallel_cutover);
+	size_t nwork = (_search_set.size() * cost) / cutover;
+	return std::min({nwork, maxthr, _search_set.size()});
+}
+
 /// search_loop() -- perform the actual pattern search
 ///
 /// This performs the actual search for matching graphs.
@@ -1099,122 +1325,204 @@ bool InitiateSearchMixin::search_loop(PatternMatchCallback& pmc,
                                       const std::string dbg_banner)
 {
 	// This is the main entry point into the CPU-cycle sucking part of
-	// the pattern search.  If `USE_THREADED_PATTERN_ENGINE` is defined,
-	// then it runs in parallel. It works, unit-tests pass. But ...
-	// But the overhead is so large, that, for small pattern matches,
-	// the setup of going parallel is far more expensive than the gain
-	// from parallelism. (RandomUTest runs 25x slower! GetStateUTest
-	// runs 33x slower!) So this code is currently disabled.
-	//
-	// If `_search_set` is large, or the if pattern is large/complex,
-	// then the extra cost might be worth it. However, this is NOT
-	// always the bottleneck! Be careful not to penalize small users!
-	// See the benchmark `nano-en.scm` in the opencog/benchmark GitHub
-	// repo, for example.
-	//
-#ifndef USE_THREADED_PATTERN_ENGINE
-	// See explanation below for the `_recursing` flag.
-	_recursing = true;
-#endif
-
-	if (_recursing)
+	// the pattern search. If the search is large enough, and the
+	// callback can handle it, then run it in parallel.  Be careful
+	// not to penalize small users! See the benchmark `nano-en.scm`
+	// in the opencog/benchmark GitHub repo, for example.
+	bool ranked = rank_search_set(pmc);
+
+	size_t nworkers = search_workers(pmc);
+	if (1 < nworkers)
 	{
-		// Plain-old, olde-fashioned sequential search loop.
-		// This works.
+		bool found = false;
+		if (parallel_search_loop(pmc, nworkers, found))
+			return found;
+
+		// If we are here, the thread pool was busy with some other
+		// search. Just do it ourselves.
+	}
+
+	// Plain-old, olde-fashioned sequential search loop.
 #ifdef QDEBUG
-		size_t i = 0, hsz = _search_set.size();
+	size_t i = 0, hsz = _search_set.size();
 #endif
 
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
+	PatternMatchEngine pme(pmc);
+	pme.set_pattern(*_variables, *_pattern, _as);
 
-		while (0 < _issued_stack.size()) _issued_stack.pop();
-		_issued.clear();
-		_issued.insert(_root);
-		for (const Handle& h : _search_set)
+	NextState& ns = next_state();
+	while (0 < ns.issued_stack.size()) ns.issued_stack.pop();
+	ns.issued.clear();
+	ns.issued.insert(_root);
+	size_t j = 0;
+	for (; j < _search_set.size(); j++)
+	{
+		// None of the remaining candidates can do any better.
+		if (ranked and _bounds[j] <= pmc.score_to_beat())
+			break;
+
+		const Handle& h = _search_set[j];
+		DO_LOG({LAZY_LOG_FINE << dbg_banner
+		             << "\n       Loop candidate ("
+		             << ++i << "/" << hsz << "):\n"
+		             << h->to_string("       ");})
+		bool found = pme.explore_neighborhood(_starter_term,
+		                                      h, _root);
+		if (found)
 		{
-			DO_LOG({LAZY_LOG_FINE << dbg_banner
-			             << "\n       Loop candidate ("
-			             << ++i << "/" << hsz << "):\n"
-			             << h->to_string("       ");})
-			bool found = pme.explore_neighborhood(_starter_term,
-			                                      h, _root);
-			if (found) return true;
+			record_plan(j+1);
+			return true;
 		}
+	}
 
-		return false;
+	record_plan(j);
+	return false;
+}
+
+/// rank_search_set() -- sort the search set, best candidates first.
+///
+/// If the callback can put an upper bound on the results to be found
+/// from each of the candidates (see `candidate_bound()`), then sort
+/// the candidates by decreasing bound, and save the bounds in
+/// `_bounds`, so that the search loop can stop early. Returns false,
+/// leaving the search set alone, if there is no bound.
+bool InitiateSearchMixin::rank_search_set(PatternMatchCallback& pmc)
+{
+	_bounds.clear();
+	if (_search_set.empty()) return false;
+
+	const Handle& term = _starter_term->getHandle();
+	double first = pmc.candidate_bound(term, _search_set[0]);
+	if (std::isnan(first)) return false;
+
+	size_t hsz = _search_set.size();
+	std::vector<std::pair<double, size_t>> order;
+	order.reserve(hsz);
+	order.emplace_back(first, 0);
+	for (size_t j = 1; j < hsz; j++)
+	{
+		double bound = pmc.candidate_bound(term, _search_set[j]);
+		if (std::isnan(bound)) bound = INFINITY;
+		order.emplace_back(bound, j);
 	}
 
-	// Note also: for multi-component patterns, this entire class
-	// is used recursively in multiple threads. This is because
-	// `PatternLink::satisfy()` is recursive, when there are multiple
-	// components. So: we start here, create multiple threads,
-	// and then pass ourselves into each thread. When there are
-	// components, this gets wrapped in PMCGroundings and then
-	// `PatternLink::satisfy()` is called .. once in each thread!
-	// Which causes a new start-point to be searched for, for each
-	// component which clobbers this structure against itself.  Fail.
-	// The `_recursing` flag prevents this double-threading.
-// #define PM_PARALLEL 1
-#ifdef PM_PARALLEL
-	// Parallel loop. This requires linking to -ltbb to work.
-	_recursing = true;
-
-	_issued_stack.clear();
-	_issued.clear();
-	_issued.insert(_root);
-
-	std::atomic<size_t> nfnd = 0;
-	std::for_each(
-		std::execution::par_unseq,
-		_search_set.begin(),
-		_search_set.end(),
-		[&](auto&& h)
+	// Break ties by position, so that the search order does not
+	// depend on the sort implementation.
+	std::sort(order.begin(), order.end(),
+		[](const std::pair<double, size_t>& a,
+		   const std::pair<double, size_t>& b)
 		{
-			PatternMatchEngine pme(pmc);
-			pme.set_pattern(*_variables, *_pattern);
-			if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
+			if (a.first != b.first) return a.first > b.first;
+			return a.second < b.second;
 		});
 
-	_recursing = false;
-	return 0 < nfnd;
+	HandleSeq ranked;
+	ranked.reserve(hsz);
+	_bounds.reserve(hsz);
+	for (const auto& pr : order)
+	{
+		ranked.emplace_back(std::move(_search_set[pr.second]));
+		_bounds.push_back(pr.first);
+	}
+	_search_set.swap(ranked);
+	return true;
+}
 
-#endif
+/// parallel_search_loop() -- run the search loop on the thread pool.
+///
+/// Each worker gets its own PatternMatchEngine, which is reused for
+/// all of the candidates that the worker handles, and its own slot of
+/// traversal state (see `next_state()`). The callback gets a chance
+/// to set up its own per-worker state, in `setup_workers()`.
+/// Candidates are handed out in small chunks, so that workers that
+/// get easy candidates do not sit idle. The first worker to find an
+/// acceptable grounding halts all of the others; so does the first
+/// exception, which is rethrown here. In a ranked search, the workers
+/// stop taking candidates once they come to one that cannot make the
+/// cut.
+///
+/// Returns false if the pool was not available, in which case nothing
+/// was searched. Otherwise, `found` holds the search result.
+bool InitiateSearchMixin::parallel_search_loop(PatternMatchCallback& pmc,
+                                               size_t nworkers,
+                                               bool& found)
+{
+	const size_t hsz = _search_set.size();
+	const size_t chunk = std::max((size_t) 1, hsz / (8 * nworkers));
+	std::atomic<size_t> next(0);
+	std::atomic<size_t> explored(0);
+	std::atomic<bool> halt(false);
+	std::atomic<bool> cutoff(false);
+	const bool ranked = not _bounds.empty();
+
+	auto job = [&](size_t)
+	{
+		try
+		{
+			PatternMatchEngine pme(pmc);
+			pme.set_pattern(*_variables, *_pattern, _as);
 
-#ifdef USE_THREADED_PATTERN_ENGINE
-	#define OMP_PM_PARALLEL 1
-#endif
-#ifdef OMP_PM_PARALLEL
-	// Parallel loop. This requires OpenMP to work.
-	_recursing = true;
-	_issued_stack.clear();
-	_issued.clear();
-	_issued.insert(_root);
+			NextState& ns = next_state();
+			ns.issued.insert(_root);
 
-#ifdef QDEBUG
-	size_t i = 0;
-#endif
+			while (not halt and not cutoff)
+			{
+				size_t start = next.fetch_add(chunk);
+				if (hsz <= start) break;
+				size_t end = std::min(start + chunk, hsz);
+				for (size_t j = start; j < end and not halt; j++)
+				{
+					// The candidates are in order of decreasing bound;
+					// once one cannot make the cut, no later one can.
+					if (ranked and _bounds[j] <= pmc.score_to_beat())
+					{
+						cutoff = true;
+						break;
+					}
+					explored ++;
+					if (pme.explore_neighborhood(_starter_term,
+					                             _search_set[j], _root))
+						halt = true;
+				}
+			}
+		}
+		catch (...)
+		{
+			halt = true;
+			throw;
+		}
+	};
 
-	std::atomic<size_t> nfnd = 0;
-	size_t hsz = _search_set.size();
-	#pragma omp parallel for
-	for (size_t j=0; j<hsz; j++)
+	setup_next_state(nworkers);
+	pmc.setup_workers(nworkers);
+	bool ran = false;
+	try
 	{
-		PatternMatchEngine pme(pmc);
-		pme.set_pattern(*_variables, *_pattern);
-		Handle h(_search_set[j]);
-		DO_LOG({LAZY_LOG_FINE << dbg_banner
-		             << "\n       Loop candidate ("
-		             << ++i << "/" << hsz << "):\n"
-		             << h->to_short_string("       ");})
-
-		if (pme.explore_neighborhood(_starter_term, h, _root)) nfnd++;
+		ran = SearchPool::instance().run(nworkers, job);
 	}
-	_recursing = false;
-	return 0 < nfnd;
-#endif
+	catch (...)
+	{
+		setup_next_state(0);
+		pmc.setup_workers(0);
+		throw;
+	}
+	setup_next_state(0);
+	pmc.setup_workers(0);
 
-	return false;
+	if (ran) record_plan(explored);
+	found = halt;
+	return ran;
+}
+
+/// record_plan() -- remember how the search went, for `explain()`.
+void InitiateSearchMixin::record_plan(size_t explored)
+{
+	Plan plan(_next_plan);
+	plan.clause = _root;
+	plan.start_term = _starter_term;
+	plan.candidates = _search_set.size();
+	plan.explored = explored;
+	_plans.emplace_back(std::move(plan));
 }
 
 /* ======================================================== */
@@ -1255,6 +1563,40 @@ std::string InitiateSearchMixin::to_string(const std::string& indent) const
 	return ss.str();
 }
 
+std::string InitiateSearchMixin::explain(const std::string& indent) const
+{
+	std::string indent_p = indent + oc_to_string_indent;
+	std::string indent_pp = indent_p + oc_to_string_indent;
+	std::stringstream ss;
+	size_t i = 0;
+	for (const Plan& plan : _plans)
+	{
+		ss << indent << "plan[" << i++ << "]: " << plan.strategy << std::endl;
+		for (const Option& opt : plan.considered)
+		{
+			bool chosen = opt.start_term == plan.start_term;
+			ss << indent_p << (chosen ? "chosen" : "considered")
+			   << ": estimate = " << opt.estimate
+			   << " cost = " << opt.cost << std::endl
+			   << opt.start_term->getHandle()->to_short_string(indent_pp)
+			   << std::endl;
+		}
+		if (plan.clause)
+			ss << indent_p << "clause:" << std::endl
+			   << plan.clause->getHandle()->to_short_string(indent_pp)
+			   << std::endl;
+		if (plan.start_term)
+			ss << indent_p << "start term:" << std::endl
+			   << plan.start_term->getHandle()->to_short_string(indent_pp)
+			   << std::endl;
+		ss << indent_p << "estimated candidates = " << plan.estimate
+		   << " cost = " << plan.cost << std::endl;
+		ss << indent_p << "actual candidates = " << plan.candidates
+		   << " explored = " << plan.explored << std::endl;
+	}
+	return ss.str();
+}
+
 std::string oc_to_string(const InitiateSearchMixin& iscb,
                          const std::string& indent)
 {
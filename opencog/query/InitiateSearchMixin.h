@@ -59,14 +59,34 @@ public:
 	virtual void next_connections(const GroundingMap&);
 	virtual bool get_next_clause(PatternTermPtr&, PatternTermPtr&);
 
+	/**
+	 * Tuning for the parallel search loop. The search is fanned out
+	 * over several threads only if the estimated amount of work is at
+	 * least `cutover` units; each additional thread requires another
+	 * `cutover` units. The work estimate is the number of starting
+	 * points, times the number of clauses in the pattern (weighted
+	 * upwards if any of them are evaluatable). Setting `max_threads`
+	 * to one disables parallel search. The defaults are a cutover of
+	 * 2048, and one thread per CPU core.
+	 */
+	static void set_parallel_cutover(size_t);
+	static void set_max_search_threads(size_t);
+
 	std::string to_string(const std::string& indent=empty_string) const;
 
+	/**
+	 * Describe the search plan(s) that were used: the places where the
+	 * search might have started, their estimated costs, the one that
+	 * was chosen, and the estimated versus actual number of candidates
+	 * that were looked at. There is one plan for each search; a pattern
+	 * with several components is searched several times.
+	 */
+	std::string explain(const std::string& indent=empty_string) const;
+
 protected:
 
 	NameServer& _nameserver;
 
-	bool _recursing;
-
 	PatternTermPtr _root;
 	PatternTermPtr _starter_term;
 	HandleSeq _search_set;
@@ -80,6 +100,32 @@ protected:
 	PatternTermPtr _curr_clause;
 	std::vector<Choice> _start_choices;
 
+	// A possible place to start the search, and what it would cost.
+	// The estimate is the expected number of candidates; the cost also
+	// accounts for the partial groundings that each candidate leads to.
+	struct Option
+	{
+		PatternTermPtr clause;
+		PatternTermPtr start_term;
+		double estimate = 0.0;
+		double cost = 0.0;
+	};
+
+	// The plan that was used for one search.
+	struct Plan : Option
+	{
+		std::string strategy;
+		std::vector<Option> considered;
+		size_t candidates = 0;   // Actual size of the search set.
+		size_t explored = 0;     // Candidates that were searched.
+	};
+	Plan _next_plan;
+	std::vector<Plan> _plans;
+	void record_plan(size_t);
+
+	double start_cost(const PatternTermPtr&, double) const;
+	double link_cost(const PatternTermPtr&) const;
+
 	virtual Handle find_starter(const PatternTermPtr&,
 	                            size_t&, PatternTermPtr&, size_t&);
 	virtual Handle find_starter_recursive(const PatternTermPtr&,
@@ -87,7 +133,7 @@ protected:
 	virtual Handle find_thinnest(const PatternTermSeq&,
 	                             PatternTermPtr&, PatternTermPtr&);
 	virtual void find_rarest(const PatternTermPtr&, PatternTermPtr&,
-	                         size_t&, Quotation quotation=Quotation());
+	                         double&, Quotation quotation=Quotation());
 
 	const PatternTermSeq& get_clause_list(void);
 
@@ -102,6 +148,10 @@ protected:
 	bool legacy_search(PatternMatchCallback&);
 	bool choice_loop(PatternMatchCallback&, const std::string);
 	bool search_loop(PatternMatchCallback&, const std::string);
+	size_t search_workers(PatternMatchCallback&);
+	bool parallel_search_loop(PatternMatchCallback&, size_t, bool&);
+	bool rank_search_set(PatternMatchCallback&);
+	std::vector<double> _bounds;
 
 	static PatternTermPtr term_of_handle(const Handle&, const PatternTermPtr&);
 	static PatternTermSeq term_choices_of_handle(const Handle&, const PatternTermPtr&);
@@ -110,13 +160,23 @@ protected:
 	// Methods and state that select the next clause to be grounded.
 	typedef std::set<PatternTermPtr> IssuedSet;
 
-	// Set of clauses for which a grounding is currently being attempted.
-	IssuedSet _issued;     // stacked on _issued_stack
-	std::stack<IssuedSet> _issued_stack;
-
 	typedef std::vector<Choice> ChoiceList;
-	ChoiceList _next_choices;
-	std::stack<ChoiceList> _choice_stack;
+
+	// Traversal state. There is one of these for a single-threaded
+	// search, and one per worker, during a parallel search.
+	struct NextState
+	{
+		// Clauses for which a grounding is currently being attempted.
+		IssuedSet issued;     // stacked on issued_stack
+		std::stack<IssuedSet> issued_stack;
+
+		ChoiceList next_choices;
+		std::stack<ChoiceList> choice_stack;
+	};
+	NextState _next_state;
+	std::vector<NextState> _worker_next_state;
+	NextState& next_state(void);
+	void setup_next_state(size_t);
 
 	Handle get_glob_embedding(const GroundingMap&, const Handle&);
 	bool get_next_thinnest_clause(const GroundingMap&, bool, bool);
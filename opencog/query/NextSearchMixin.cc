@@ -27,6 +27,7 @@
 
 #include "InitiateSearchMixin.h"
 #include "PatternMatchEngine.h"
+#include "SearchPool.h"
 
 // #define QDEBUG 1
 #ifdef QDEBUG
@@ -39,15 +40,31 @@ using namespace opencog;
 
 /* ======================================================== */
 
+/// Return the traversal state for the current thread. The per-worker
+/// states exist only while a parallel search is running.
+InitiateSearchMixin::NextState& InitiateSearchMixin::next_state(void)
+{
+	if (_worker_next_state.empty()) return _next_state;
+	return _worker_next_state[SearchPool::worker_id()];
+}
+
+void InitiateSearchMixin::setup_next_state(size_t nworkers)
+{
+	_worker_next_state.clear();
+	_worker_next_state.resize(nworkers);
+}
+
 void InitiateSearchMixin::push(void)
 {
-	_issued_stack.push(_issued);
+	NextState& ns = next_state();
+	ns.issued_stack.push(ns.issued);
 }
 
 void InitiateSearchMixin::pop(void)
 {
-	_issued = _issued_stack.top();
-	_issued_stack.pop();
+	NextState& ns = next_state();
+	ns.issued = ns.issued_stack.top();
+	ns.issued_stack.pop();
 }
 
 /**
@@ -84,29 +101,31 @@ void InitiateSearchMixin::pop(void)
 bool InitiateSearchMixin::get_next_clause(PatternTermPtr& clause,
                                           PatternTermPtr& joint)
 {
-	if (0 == _next_choices.size())
+	NextState& ns = next_state();
+	if (0 == ns.next_choices.size())
 	{
-		if (0 < _choice_stack.size())
+		if (0 < ns.choice_stack.size())
 		{
-			_next_choices = _choice_stack.top();
-			_choice_stack.pop();
+			ns.next_choices = ns.choice_stack.top();
+			ns.choice_stack.pop();
 		}
 		return false;
 	}
 
-	const Choice& ch(_next_choices.back());
+	const Choice& ch(ns.next_choices.back());
 	clause = ch.clause;
 	joint = ch.start_term;
-	_next_choices.pop_back();
+	ns.next_choices.pop_back();
 
-	_issued.insert(clause);
+	ns.issued.insert(clause);
 	return true;
 }
 
 void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 {
-	_choice_stack.push(_next_choices);
-	_next_choices.clear();
+	NextState& ns = next_state();
+	ns.choice_stack.push(ns.next_choices);
+	ns.next_choices.clear();
 
 	// First, try to ground all the mandatory clauses, only.
 	// no virtuals, no black boxes, no absents.
@@ -132,7 +151,7 @@ void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 	// All variables must necessarily be grounded at this point.
 	for (const PatternTermPtr& root : _pattern->always)
 	{
-		if (_issued.end() != _issued.find(root)) continue;
+		if (ns.issued.end() != ns.issued.find(root)) continue;
 		for (const Handle &v : _variables->varset)
 		{
 			if (is_free_in_tree(root->getHandle(), v))
@@ -140,7 +159,7 @@ void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 				Choice ch;
 				ch.clause = root;
 				ch.start_term = term_of_handle(v, root);
-				_next_choices.emplace_back(ch);
+				ns.next_choices.emplace_back(ch);
 				return;
 			}
 		}
@@ -162,7 +181,7 @@ void InitiateSearchMixin::next_connections(const GroundingMap& var_grounding)
 		if (is_constraint_excl)
 			continue;
 
-		if (_issued.end() == _issued.find(root))
+		if (ns.issued.end() == ns.issued.find(root))
 		{
 			throw RuntimeException(TRACE_INFO,
 				"BUG! Still have ungrounded clauses!!");
@@ -218,6 +237,7 @@ unsigned int InitiateSearchMixin::thickness(const PatternTermPtr& clause,
 Handle InitiateSearchMixin::get_glob_embedding(const GroundingMap& var_grounding,
                                                const Handle& glob)
 {
+	NextState& ns = next_state();
 	// If the glob is in only one clause, there is no connectivity map.
 	if (0 == _pattern->connectivity_map.count(glob)) return glob;
 
@@ -230,7 +250,7 @@ Handle InitiateSearchMixin::get_glob_embedding(const GroundingMap& var_grounding
 	auto clpr = clauses.first;
 	for (; clpr != clauses.second; clpr++)
 	{
-		if (_issued.end() == _issued.find(clpr->second)) break;
+		if (ns.issued.end() == ns.issued.find(clpr->second)) break;
 	}
 
 	// Glob is not in any ungrounded clauses.
@@ -272,6 +292,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
                                                    bool search_eval,
                                                    bool search_absents)
 {
+	NextState& ns = next_state();
 	// Make a list of the as-yet ungrounded variables.
 	HandleSet ungrounded_vars;
 
@@ -339,7 +360,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 		for (auto it = root_list.first; it != root_list.second; it++)
 		{
 			const PatternTermPtr& root = it->second;
-			bool already_issued = (_issued.end() != _issued.find(root));
+			bool already_issued = (ns.issued.end() != ns.issued.find(root));
 			bool has_eval = root->hasAnyEvaluatable();
 			bool is_absent = root->isAbsent();
 
@@ -396,7 +417,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 			for (auto it = root_list.first; it != root_list.second; it++)
 			{
 				const PatternTermPtr& root = it->second;
-				bool already_issued = (_issued.end() != _issued.find(root));
+				bool already_issued = (ns.issued.end() != ns.issued.find(root));
 				bool has_eval = root->hasAnyEvaluatable();
 				bool is_absent = root->isAbsent();
 
@@ -443,7 +464,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 	{
 		for (const PatternTermPtr& root : _pattern->pmandatory)
 		{
-			if (_issued.end() != _issued.find(root)) continue;
+			if (ns.issued.end() != ns.issued.find(root)) continue;
 
 			// Clauses with no variables are (by definition)
 			// evaluatable. So we don't check if they're evaluatable.
@@ -453,7 +474,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 				Choice ch;
 				ch.clause = root;
 				ch.start_term = root;
-				_next_choices.emplace_back(ch);
+				ns.next_choices.emplace_back(ch);
 				return true;
 			}
 		}
@@ -470,11 +491,11 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 			Choice ch;
 			ch.clause = unsolved_clause;
 			ch.start_term = term_of_handle(joint, alt);
-			_next_choices.emplace_back(ch);
+			ns.next_choices.emplace_back(ch);
 		}
 
 		// Special case.
-		_issued.insert(unsolved_clause);
+		ns.issued.insert(unsolved_clause);
 	}
 	else
 	{
@@ -484,7 +505,7 @@ bool InitiateSearchMixin::get_next_thinnest_clause(const GroundingMap& var_groun
 			Choice ch;
 			ch.clause = unsolved_clause;
 			ch.start_term = stm;
-			_next_choices.emplace_back(ch);
+			ns.next_choices.emplace_back(ch);
 		}
 	}
 	return true;
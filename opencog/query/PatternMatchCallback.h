@@ -24,7 +24,9 @@
 #ifndef _OPENCOG_PATTERN_MATCH_CALLBACK_H
 #define _OPENCOG_PATTERN_MATCH_CALLBACK_H
 
+#include <cmath>
 #include <map>
+#include <mutex>
 #include <set>
 #include <opencog/atoms/base/Handle.h>
 #include <opencog/atoms/base/Link.h>
@@ -292,6 +294,20 @@ class PatternMatchCallback
 			return h->getIncomingSetByType(t);
 		}
 
+		/**
+		 * Same as above, when it is known that the Links of interest
+		 * have arity `arity`, and hold `h` at position `pos`. Those
+		 * that don't can be left out, but don't have to be; they are
+		 * rejected later, anyway. The default just calls the above.
+		 */
+		virtual IncomingSet get_incoming_by_position(const Handle& h,
+		                                             Type t,
+		                                             Arity arity,
+		                                             Arity pos)
+		{
+			return get_incoming_set(h, t);
+		}
+
 		/**
 		 * Called whenever there is a need to verify that the given
 		 * Link(t, oset) appears in the incoming set of `hg`. That is,
@@ -344,6 +360,50 @@ class PatternMatchCallback
 		 */
 		virtual bool search_finished(bool done) { return done; }
 
+		/**
+		 * Return true if the callbacks may be invoked concurrently,
+		 * from several threads, during a single search. If so, the
+		 * search loop is free to explore different starting points
+		 * in different threads, when the search is large enough to
+		 * be worth it. The default is false: the callbacks are always
+		 * invoked from a single thread.
+		 *
+		 * A thread-safe callback must protect `propose_grounding()`
+		 * (and any other shared state) with a lock, and must keep any
+		 * per-traversal state in per-worker slots; see `setup_workers()`.
+		 */
+		virtual bool is_thread_safe(void) { return false; }
+
+		/**
+		 * Called just before the search loop fans out over `nworkers`
+		 * threads, and again, with zero, after it has finished. This
+		 * gives the callee the chance to allocate per-thread state.
+		 * During the parallel search, the state for the current thread
+		 * is found at index `SearchPool::worker_id()`.
+		 */
+		virtual void setup_workers(size_t nworkers) {}
+
+		/**
+		 * Ranked searches. A callback that keeps only the best few
+		 * results may be able to say, before a candidate starting
+		 * point is explored, how good any result found from it can
+		 * possibly be. Here, `term` is the term the search starts
+		 * from, and `grnd` is the proposed grounding for it. Return
+		 * an upper bound on the score, or NAN if there is none.
+		 *
+		 * If there is a bound, the candidates are explored in order
+		 * of decreasing bound, and the search loop stops as soon as
+		 * the bound is no better than `score_to_beat()`. That, in
+		 * turn, should return NAN, for as long as any result at all
+		 * would be kept. It may be called from several threads.
+		 */
+		virtual double candidate_bound(const Handle& term,
+		                               const Handle& grnd)
+		{
+			return NAN;
+		}
+		virtual double score_to_beat(void) { return NAN; }
+
 		/**
 		 * A pair of functions that are called to obtain the set of
 		 * clauses to explore next. These are clauses that contain
@@ -396,16 +456,11 @@ class PatternMatchCallback
 		virtual bool satisfy(const PatternLinkPtr&) = 0;
 };
 
-// See notes in `InitiateSearchMixin.cc` for an explanation of the
-// threading code and its status.
-// #define USE_THREADED_PATTERN_ENGINE
-#ifdef USE_THREADED_PATTERN_ENGINE
-	#define DECLARE_PE_MUTEX std::mutex _mtx;
-	#define LOCK_PE_MUTEX std::lock_guard<std::mutex> lck(_mtx);
-#else
-	#define DECLARE_PE_MUTEX
-	#define LOCK_PE_MUTEX
-#endif // USE_THREADED_PATTERN_ENGINE
+// Lock protecting the shared state of a thread-safe callback, such as
+// the result set. See `is_thread_safe()` above, and the notes on the
+// parallel search in `InitiateSearchMixin.cc`.
+#define DECLARE_PE_MUTEX std::mutex _mtx;
+#define LOCK_PE_MUTEX std::lock_guard<std::mutex> lck(_mtx);
 
 } // namespace opencog
 
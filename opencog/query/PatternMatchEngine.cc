@@ -785,37 +785,37 @@ bool PatternMatchEngine::have_perm(const PatternTermPtr& ptm)
 
 void PatternMatchEngine::perm_push(void)
 {
-	_perm_stack.push(_perm_state);
+	_perm_state.mark();
 #ifdef QDEBUG
 	if (logger().is_fine_enabled())
 		_perm_count_stack.push(_perm_count);
 #endif
 
-	_perm_stepper_stack.push(_perm_to_step);
-	_perm_take_stack.push(_perm_take_step);
-	_perm_more_stack.push(_perm_have_more);
-	_perm_breakout_stack.push(_perm_breakout);
+	_perm_flag_stack.push_back({_perm_to_step, _perm_breakout,
+	                            _perm_take_step, _perm_have_more});
 
-	_perm_odo_stack.push(_perm_odo_state);
+	_perm_odo_state.mark();
 }
 
 void PatternMatchEngine::perm_pop(void)
 {
-	POPSTK(_perm_stack, _perm_state);
+	_perm_state.undo();
 #ifdef QDEBUG
 	if (logger().is_fine_enabled())
 		POPSTK(_perm_count_stack, _perm_count);
 #endif
 
-	POPSTK(_perm_stepper_stack, _perm_to_step)
-	POPSTK(_perm_take_stack, _perm_take_step);
-	POPSTK(_perm_more_stack, _perm_have_more);
-	POPSTK(_perm_breakout_stack, _perm_breakout);
+	const PermFlags& pf = _perm_flag_stack.back();
+	_perm_to_step = pf.to_step;
+	_perm_breakout = pf.breakout;
+	_perm_take_step = pf.take_step;
+	_perm_have_more = pf.have_more;
+	_perm_flag_stack.pop_back();
 
 	// XXX should we be clearing ... or popping this flag?
 	_perm_go_around = false;
 
-	POPSTK(_perm_odo_stack, _perm_odo_state);
+	_perm_odo_state.undo();
 }
 
 /* ======================================================== */
@@ -1731,9 +1731,21 @@ bool PatternMatchEngine::explore_upord_branches(const PatternTermPtr& ptm,
 
 	// If we are here, then somehow the upward-term is not unique, and
 	// we have to explore the incoming set of the ground to see which
-	// (if any) of the incoming set satisfies the parent term.
+	// (if any) of the incoming set satisfies the parent term. Only
+	// those with the ground in the same place as `ptm` can; the
+	// callback may be able to weed out the others, up front. This
+	// needs the terms to line up with the outgoing set, one-to-one.
+	const Handle& hpar(parent->getHandle());
+	Arity pos = 0;
+	while (parent->getOutgoingTerm(pos) != ptm) pos++;
 
-	IncomingSet iset = _pmc.get_incoming_set(hg, t);
+	IncomingSet iset;
+	if (hpar->is_unordered_link() or
+	    hpar->get_arity() != parent->getArity() or
+	    hpar->getOutgoingAtom(pos) != ptm->getHandle())
+		iset = _pmc.get_incoming_set(hg, t);
+	else
+		iset = _pmc.get_incoming_by_position(hg, t, parent->getArity(), pos);
 	size_t sz = iset.size();
 	DO_LOG({LAZY_LOG_FINE << "Looking upward at ordered term = "
 	                      << parent->getQuote()->to_string() << std::endl
@@ -1897,12 +1909,12 @@ bool PatternMatchEngine::explore_upglob_branches(const PatternTermPtr& ptm,
 		// their state will be recorded in _glob_state, so that one can,
 		// if needed, resume and try to ground those globs again in a
 		// different way (e.g. backtracking from another branchpoint).
-		auto saved_glob_state = _glob_state;
+		_glob_state.mark();
 
 		found = explore_glob_branches(parent, iset[i], clause);
 
 		// Restore the saved state, for the next go-around.
-		_glob_state = saved_glob_state;
+		_glob_state.undo();
 
 		if (found) break;
 	}
@@ -2172,9 +2184,9 @@ bool PatternMatchEngine::explore_choice_branches(const PatternTermPtr& ptm,
 		// should resemble the perm_push() used for unordered links.
 		// However, currently, no test case trips this up. so .. OK.
 		// Whatever. This still probably needs fixing.
-		if (_need_choice_push) choice_stack.push(_choice_state);
+		if (_need_choice_push) _choice_state.mark();
 		bool match = explore_single_branch(ptm, hg, clause);
-		if (_need_choice_push) POPSTK(choice_stack, _choice_state);
+		if (_need_choice_push) _choice_state.undo();
 		_need_choice_push = false;
 
 		// If the pattern was satisfied, then we are done for good.
@@ -2561,7 +2573,8 @@ bool PatternMatchEngine::clause_accept(const PatternTermPtr& clause,
 				if (_gnd_cache.end() != prev)
 					OC_ASSERT(prev->second == hg, "Internal Error");
 #endif
-				_gnd_cache.insert({key, hg});
+				if (_gnd_cache.insert({key, hg}).second and _pcache)
+					_pcache->insert(_pcache_ticket, key, hg);
 			}
 		}
 	}
@@ -2705,10 +2718,10 @@ void PatternMatchEngine::clause_stacks_push(void)
 	_clause_stack_depth++;
 	logmsg("--- CLAUSE stack push to depth=", _clause_stack_depth);
 
-	var_solutn_stack.push(var_grounding);
-	_clause_solutn_stack.push(clause_grounding);
+	var_grounding.mark();
+	clause_grounding.mark();
 
-	choice_stack.push(_choice_state);
+	_choice_state.mark();
 
 	perm_push();
 
@@ -2737,10 +2750,10 @@ void PatternMatchEngine::clause_stacks_pop(void)
 	_pmc.pop();
 
 	// The grounding stacks are handled differently.
-	POPSTK(_clause_solutn_stack, clause_grounding);
-	POPSTK(var_solutn_stack, var_grounding);
+	clause_grounding.undo();
+	var_grounding.undo();
 
-	POPSTK(choice_stack, _choice_state);
+	_choice_state.undo();
 
 	perm_pop();
 
@@ -2760,25 +2773,26 @@ void PatternMatchEngine::clause_stacks_clear(void)
 	_clause_stack_depth = 0;
 #if 0
 	// Currently, only GlobUTest fails when this is uncommented.
-	OC_ASSERT(0 == _clause_solutn_stack.size());
-	OC_ASSERT(0 == var_solutn_stack.size());
-	OC_ASSERT(0 == choice_stack.size());
-	OC_ASSERT(0 == _perm_stack.size());
-	OC_ASSERT(0 == _perm_stepper_stack.size());
+	OC_ASSERT(0 == clause_grounding.depth());
+	OC_ASSERT(0 == var_grounding.depth());
+	OC_ASSERT(0 == _choice_state.depth());
+	OC_ASSERT(0 == _perm_state.depth());
+	OC_ASSERT(0 == _perm_flag_stack.size());
 #else
-	while (!_clause_solutn_stack.empty()) _clause_solutn_stack.pop();
-	while (!var_solutn_stack.empty()) var_solutn_stack.pop();
-	while (!choice_stack.empty()) choice_stack.pop();
-	while (!_perm_stack.empty()) _perm_stack.pop();
-	while (!_perm_stepper_stack.empty()) _perm_stepper_stack.pop();
+	clause_grounding.forget();
+	var_grounding.forget();
+	_choice_state.forget();
+	_perm_state.forget();
+	_perm_odo_state.forget();
+	_perm_flag_stack.clear();
 	while (!_perm_step_saver.empty()) _perm_step_saver.pop();
 #endif
 }
 
 void PatternMatchEngine::solution_push(void)
 {
-	var_solutn_stack.push(var_grounding);
-	_clause_solutn_stack.push(clause_grounding);
+	var_grounding.mark();
+	clause_grounding.mark();
 
 	// Save constraint propagation state for backtracking
 	if (_use_constraint_domain)
@@ -2787,8 +2801,8 @@ void PatternMatchEngine::solution_push(void)
 
 void PatternMatchEngine::solution_pop(void)
 {
-	POPSTK(var_solutn_stack, var_grounding);
-	POPSTK(_clause_solutn_stack, clause_grounding);
+	var_grounding.undo();
+	clause_grounding.undo();
 
 	// Restore constraint propagation state
 	if (_use_constraint_domain)
@@ -2797,8 +2811,8 @@ void PatternMatchEngine::solution_pop(void)
 
 void PatternMatchEngine::solution_drop(void)
 {
-	var_solutn_stack.pop();
-	_clause_solutn_stack.pop();
+	var_grounding.drop();
+	clause_grounding.drop();
 
 	// Discard saved constraint state without restoring
 	if (_use_constraint_domain)
@@ -3190,7 +3204,18 @@ bool PatternMatchEngine::explore_clause_cacheable(const PatternTermPtr& term,
 	if (0 == key.size())
 		return explore_clause_direct(term, grnd, pclause);
 
-	const auto& cac = _gnd_cache.find(key);
+	auto cac = _gnd_cache.find(key);
+
+	// Not grounded in this search; maybe in an earlier one? But if it
+	// was already explored in this one, then the negative cache below
+	// must have its say.
+	if (cac == _gnd_cache.end() and _pcache and
+	    _nack_cache.find(key) == _nack_cache.end())
+	{
+		Handle hg(_pcache->lookup(key));
+		if (hg) cac = _gnd_cache.insert({key, hg}).first;
+	}
+
 	if (cac != _gnd_cache.end())
 	{
 		logmsg("Cache hit!");
@@ -3318,7 +3343,9 @@ PatternMatchEngine::PatternMatchEngine(PatternMatchCallback& pmcb)
 	_nameserver(nameserver()),
 	_variables(nullptr),
 	_pat(nullptr),
-	clause_accepted(false)
+	clause_accepted(false),
+	_pcache(nullptr),
+	_pcache_ticket(0)
 {
 	// current state
 	depth = 0;
@@ -3345,10 +3372,18 @@ PatternMatchEngine::PatternMatchEngine(PatternMatchCallback& pmcb)
 }
 
 void PatternMatchEngine::set_pattern(const Variables& v,
-                                     const Pattern& p)
+                                     const Pattern& p,
+                                     AtomSpace* as)
 {
 	_variables = &v;
 	_pat = &p;
+
+	_pcache = nullptr;
+	if (as and p.gnd_cache)
+	{
+		_pcache = p.gnd_cache.get();
+		_pcache_ticket = _pcache->refresh(as);
+	}
 	init_constraint_domains();
 }
 
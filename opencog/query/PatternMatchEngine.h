@@ -32,7 +32,9 @@
 #include <opencog/atoms/atom_types/NameServer.h>
 #include <opencog/atoms/pattern/Pattern.h>
 #include <opencog/query/ConstraintDomain.h>
+#include <opencog/query/GroundingCache.h>
 #include <opencog/query/PatternMatchCallback.h>
+#include <opencog/query/TrailMap.h>
 
 namespace opencog {
 
@@ -71,13 +73,17 @@ private:
 	// Note, though, that these are cumulative: so e.g. the
 	// var_grounding map accumulates variable groundings for this
 	// clause, and all previous clauses so far.
+	//
+	// The maps below are TrailMaps: instead of pushing a copy of the
+	// whole map onto a stack when backtracking might be needed, only
+	// the changes are logged, and are undone when backtracking.
 
 	// Map of current groundings of variables to their grounds
 	// Also contains grounds of subclauses (not sure why, this seems
 	// to be needed)
-	GroundingMap var_grounding;
+	TrailMap<GroundingMap> var_grounding;
 	// Map of clauses to their current groundings
-	GroundingMap clause_grounding;
+	TrailMap<GroundingMap> clause_grounding;
 
 	// Insert association between pattern ptm and its grounding hg into
 	// var_grounding.
@@ -96,7 +102,7 @@ private:
 	// Similar to permutation state management.
 	typedef std::map<PatternTermPtr, size_t> ChoiceState;
 
-	ChoiceState _choice_state;
+	TrailMap<ChoiceState> _choice_state;
 	bool _need_choice_push;
 
 	size_t curr_choice(const PatternTermPtr&, const Handle&);
@@ -115,7 +121,7 @@ private:
 	typedef std::map<PatternTermPtr, bool> PermOdo;
 	typedef std::map<PatternTermPtr, PermOdo> PermOdoState;
 
-	PermState _perm_state;
+	TrailMap<PermState> _perm_state;
 	Permutation curr_perm(const PatternTermPtr&);
 	bool have_perm(const PatternTermPtr&);
 
@@ -130,15 +136,18 @@ private:
 
 	PermOdo _perm_odo;
 	PermOdo _perm_podo;
-	PermOdoState _perm_odo_state;
-
-	std::stack<bool> _perm_take_stack;
-	std::stack<bool> _perm_more_stack;
-	std::stack<PatternTermPtr> _perm_stepper_stack;
-	std::stack<PatternTermPtr> _perm_breakout_stack;
-	std::stack<PermOdoState> _perm_odo_stack;
+	TrailMap<PermOdoState> _perm_odo_state;
+
+	// The flags above, saved by perm_push().
+	struct PermFlags
+	{
+		PatternTermPtr to_step;
+		PatternTermPtr breakout;
+		bool take_step;
+		bool have_more;
+	};
+	std::vector<PermFlags> _perm_flag_stack;
 
-	std::stack<PermState> _perm_stack;
 	PermCount _perm_count;
 	std::stack<PermCount> _perm_count_stack;
 
@@ -150,7 +159,7 @@ private:
 
 	// Record where the globs are (branchpoints)
 	typedef std::pair<PatternTermPtr, std::pair<size_t, size_t>> GlobPos;
-	typedef std::stack<GlobPos> GlobPosStack;
+	typedef std::stack<GlobPos, std::vector<GlobPos>> GlobPosStack;
 
 	// Record how many atoms have been grounded to the globs
 	typedef std::map<PatternTermPtr, size_t> GlobGrd;
@@ -161,7 +170,7 @@ private:
 	// performance difference between these two, but could not find one,
 	// at least with the `guile -l nano-en.scm` benchmark.
 	// (As of Dec 2019, using gcc-8.3.0 and glibc-2.28)
-	std::map<PatternTermSeq, GlobState> _glob_state;
+	TrailMap<std::map<PatternTermSeq, GlobState>> _glob_state;
 	// std::unordered_map<PatternTermSeq, GlobState> _glob_state;
 
 	// --------------------------------------------
@@ -216,6 +225,10 @@ private:
 	std::unordered_map<HandleSeq, Handle> _gnd_cache;
 	std::unordered_set<HandleSeq> _nack_cache;
 
+	// Positive cache that outlives this engine; may be null.
+	GroundingCache* _pcache;
+	uint64_t _pcache_ticket;
+
 	// -------------------------------------------
 	// Stack used to store current traversal state for a single
 	// clause. These are pushed when a clause is fully grounded,
@@ -226,12 +239,6 @@ private:
 	void solution_pop(void);
 	void solution_drop(void);
 
-	// Stacks containing partial groundings.
-	std::stack<GroundingMap> var_solutn_stack;
-	std::stack<GroundingMap> _clause_solutn_stack;
-
-	std::stack<ChoiceState> choice_stack;
-
 	// push, pop and clear these states.
 	void clause_stacks_push(void);
 	void clause_stacks_pop(void);
@@ -325,7 +332,10 @@ private:
 
 public:
 	PatternMatchEngine(PatternMatchCallback&);
-	void set_pattern(const Variables&, const Pattern&);
+	// Searches in an AtomSpace can use the pattern's grounding
+	// cache, if it has one.
+	void set_pattern(const Variables&, const Pattern&,
+	                 AtomSpace* = nullptr);
 
 	// Examine the locally connected neighborhood for possible
 	// matches.
@@ -17,8 +17,10 @@
  */
 
 #include <opencog/atoms/atom_types/atom_types.h>
+#include <opencog/atoms/core/NumberNode.h>
 #include <opencog/atoms/grant/DefineLink.h>
 #include <opencog/atoms/free/Replacement.h>
+#include <opencog/atoms/value/FloatValue.h>
 #include <opencog/atomspace/AtomSpace.h>
 
 #include "RewriteMixin.h"
@@ -27,7 +29,8 @@ using namespace opencog;
 
 RewriteMixin::RewriteMixin(AtomSpace* as, ContainerValuePtr& qvp)
 	: _as(as), _result_queue(qvp),
-	_num_results(0), max_results(SIZE_MAX)
+	_num_results(0), _cutoff(NAN), _bound_ok(false),
+	max_results(SIZE_MAX), streaming(false), top_k(0)
 {
 }
 
@@ -135,14 +138,33 @@ static ValuePtr instantiate(AtomSpace* as,
 bool RewriteMixin::propose_grounding(const GroundingMap& var_soln,
                                      const GroundingMap& term_soln)
 {
-	LOCK_PE_MUTEX;
 	// PatternMatchEngine::print_solution(var_soln, term_soln);
 
-	// If we found as many as we want, then stop looking for more.
-	if (_num_results >= max_results)
-		return true;
+	// In a ranked search, there is no point in instantiating a result
+	// that cannot make the cut.
+	double sc = NAN;
+	if (0 < top_k)
+	{
+		sc = ground_score(var_soln);
+		if (not makes_cut(sc))
+			return false;
+	}
 
-	_num_results ++;
+	{
+		// If we found as many as we want, then stop looking for more.
+		// Likewise, if the reader has stopped reading.
+		LOCK_PE_MUTEX;
+		if (_num_results >= max_results)
+			return true;
+		if (streaming and _result_queue->is_closed())
+			return true;
+
+		_num_results ++;
+	}
+
+	// The instantiation is done without holding the lock, so that
+	// a parallel search does not serialize on it. The marginals and
+	// the result queue are thread-safe containers.
 
 	// Record marginals for variables.
 	record_marginals(var_soln);
@@ -158,7 +180,7 @@ bool RewriteMixin::propose_grounding(const GroundingMap& var_soln,
 			auto it = _implicand_grnds.find(_implicand[0]);
 			if (_implicand_grnds.end() != it)
 				(*it).second->add(v);
-			insert_result(v);
+			insert_result(v, sc);
 		}
 	}
 	else
@@ -177,16 +199,20 @@ bool RewriteMixin::propose_grounding(const GroundingMap& var_soln,
 				vs.emplace_back(v);
 			}
 		}
-		insert_result(createLinkValue(std::move(vs)));
+		insert_result(createLinkValue(std::move(vs)), sc);
 	}
 
 	// If we found as many as we want, then stop looking for more.
+	LOCK_PE_MUTEX;
+	if (streaming and _result_queue->is_closed())
+		return true;
 	return (_num_results >= max_results);
 }
 
-void RewriteMixin::insert_result(ValuePtr v)
+void RewriteMixin::insert_result(ValuePtr v, double score)
 {
-	if (_result_set.end() != _result_set.find(v)) return;
+	LOCK_PE_MUTEX;
+	if (0 == top_k and _result_set.end() != _result_set.find(v)) return;
 
 	// Insert atom into the atomspace immediately. This avoids having
 	// the atom appear twice, once unassigned to any AS, and the other
@@ -194,14 +220,187 @@ void RewriteMixin::insert_result(ValuePtr v)
 	if (v->is_atom())
 		v = _as->add_atom(HandleCast(v));
 
+	if (0 < top_k)
+	{
+		insert_ranked(std::move(v), score);
+		return;
+	}
+
 	if (_result_set.end() != _result_set.find(v)) return;
 
 	_result_set.insert(v);
-	_result_queue->add(std::move(v));
+	push_result(std::move(v));
+}
+
+/// Hand one result over to the reader.
+void RewriteMixin::push_result(ValuePtr v)
+{
+	if (not streaming)
+	{
+		_result_queue->add(std::move(v));
+		return;
+	}
+
+	// The add blocks if the reader is behind. The reader may close the
+	// queue before or while we wait; the add then throws. That is not
+	// an error; propose_grounding() will stop the search.
+	if (_result_queue->is_closed()) return;
+	try { _result_queue->add(std::move(v)); }
+	catch (...) {}
+}
+
+/// Keep `v` if it is one of the `top_k` best so far, dropping the
+/// worst of the others, if need be. Must be called with the lock held.
+void RewriteMixin::insert_ranked(ValuePtr v, double score)
+{
+	if (_result_set.end() != _result_set.find(v))
+	{
+		// Found before, possibly with a different score.
+		for (auto it = _top.begin(); it != _top.end(); it++)
+		{
+			if (it->second != v) continue;
+			if (score <= it->first) return;
+			_top.erase(it);
+			_top.emplace(score, std::move(v));
+			break;
+		}
+	}
+	else
+	{
+		// The cutoff might have gone up, since the caller looked.
+		if (top_k <= _top.size() and score <= _top.begin()->first)
+			return;
+
+		_result_set.insert(v);
+		_top.emplace(score, std::move(v));
+		if (top_k < _top.size())
+		{
+			auto worst = _top.begin();
+			_result_set.erase(worst->second);
+			_top.erase(worst);
+		}
+	}
+
+	if (top_k <= _top.size())
+		_cutoff = _top.begin()->first;
+}
+
+/* ================================================================= */
+
+/// Convert the result of executing the score into a number. A missing
+/// score (e.g. no Value at the key) ranks below everything else.
+static double to_score(const ValuePtr& vp)
+{
+	double d = NAN;
+	if (nullptr == vp)
+		return -INFINITY;
+	else if (vp->is_type(FLOAT_VALUE))
+	{
+		const std::vector<double>& fv(FloatValueCast(vp)->value());
+		if (0 < fv.size()) d = fv[0];
+	}
+	else if (vp->is_type(NUMBER_NODE))
+	{
+		const std::vector<double>& nv(NumberNodeCast(HandleCast(vp))->value());
+		if (0 < nv.size()) d = nv[0];
+	}
+	else
+		throw InvalidParamException(TRACE_INFO,
+			"Expecting the score to be a number, got %s",
+			vp->to_string().c_str());
+
+	if (std::isnan(d)) return -INFINITY;
+	return d;
+}
+
+/// Execute the grounded score expression.
+double RewriteMixin::get_score(const Handle& expr) const
+{
+	try
+	{
+		if (expr->is_executable())
+			return to_score(expr->execute(_as, true));
+	}
+	catch (const SilentException&)
+	{
+		return -INFINITY;
+	}
+	return to_score(expr);
+}
+
+double RewriteMixin::ground_score(const GroundingMap& var_soln) const
+{
+	if (nullptr == score)
+		throw InvalidParamException(TRACE_INFO,
+			"Asked for the top %zu results, but there is no score!", top_k);
+
+	return get_score(Replacement::replace_nocheck(score, var_soln));
+}
+
+/// Return true if `expr` contains no variables, except inside of
+/// `term`. Set `found` if it contains `term` at all.
+static bool bound_by(const Handle& expr, const Handle& term, bool& found)
+{
+	if (expr == term or *expr == *term)
+	{
+		found = true;
+		return true;
+	}
+
+	Type t = expr->get_type();
+	if (VARIABLE_NODE == t or GLOB_NODE == t) return false;
+	if (not expr->is_link()) return true;
+
+	for (const Handle& h : expr->getOutgoingSet())
+		if (not bound_by(h, term, found)) return false;
+	return true;
+}
+
+/// Replace every occurrence of `term` in `expr` by `grnd`.
+static Handle replace_term(const Handle& expr, const Handle& term,
+                           const Handle& grnd)
+{
+	if (expr == term or *expr == *term) return grnd;
+	if (not expr->is_link()) return expr;
+
+	bool changed = false;
+	HandleSeq oset;
+	for (const Handle& h : expr->getOutgoingSet())
+	{
+		oset.emplace_back(replace_term(h, term, grnd));
+		if (oset.back() != h) changed = true;
+	}
+	if (not changed) return expr;
+	return createLink(std::move(oset), expr->get_type());
+}
+
+/**
+ * If the score depends on the groundings only through the starting
+ * term, then all of the results found from a given grounding of that
+ * term have the same score. This is the best possible upper bound,
+ * and it is computed without having to search anything.
+ */
+double RewriteMixin::candidate_bound(const Handle& term, const Handle& grnd)
+{
+	if (0 == top_k or nullptr == score) return NAN;
+
+	if (term != _bound_term)
+	{
+		bool found = false;
+		_bound_ok = bound_by(score, term, found) and found;
+		_bound_term = term;
+	}
+	if (not _bound_ok) return NAN;
+
+	return get_score(replace_term(score, term, grnd));
 }
 
 bool RewriteMixin::start_search(void)
 {
+	// The queue was opened for the reader, who might have closed it
+	// already. Either way, it must not be re-opened here.
+	if (streaming) return false;
+
 	if (_result_queue->is_closed())
 	{
 		_result_queue->clear();
@@ -218,7 +417,14 @@ bool RewriteMixin::search_finished(bool done)
 	for (auto& igs : _implicand_grnds)
 		igs.second->close();
 
-	_result_queue->close();
+	// Deliver the ranked results, best first.
+	for (auto it = _top.rbegin(); it != _top.rend(); it++)
+		push_result(it->second);
+	_top.clear();
+	_cutoff = NAN;
+
+	if (not streaming)
+		_result_queue->close();
 	return done;
 }
 
@@ -24,6 +24,9 @@
 #ifndef _OPENCOG_REWRITE_MIXIN_H
 #define _OPENCOG_REWRITE_MIXIN_H
 
+#include <atomic>
+#include <cmath>
+#include <map>
 #include <vector>
 
 #include <opencog/atomspace/AtomSpace.h>
@@ -60,7 +63,9 @@ class RewriteMixin :
 		DECLARE_PE_MUTEX;
 		ValueSet _result_set;
 		ContainerValuePtr _result_queue;
-		void insert_result(ValuePtr);
+		void insert_result(ValuePtr, double score=NAN);
+		void insert_ranked(ValuePtr, double);
+		void push_result(ValuePtr);
 
 		PatternLinkPtr _plp;
 		HandleSeq _varseq;
@@ -76,10 +81,47 @@ class RewriteMixin :
 		void record_marginals(const GroundingMap&);
 
 		size_t _num_results;
+
+		// Ranked search state. `_top` holds the best results found so
+		// far, and `_cutoff` is the score that a new one must beat.
+		std::multimap<double, ValuePtr> _top;
+		std::atomic<double> _cutoff;
+		Handle _bound_term;
+		bool _bound_ok;
+		double get_score(const Handle&) const;
+		double ground_score(const GroundingMap&) const;
+		bool makes_cut(double score) const
+		{
+			double cut = _cutoff;
+			return std::isnan(cut) or cut < score;
+		}
 	public:
 		RewriteMixin(AtomSpace*, ContainerValuePtr&);
 		size_t max_results;
 
+		/// Set when results are streamed to a reader as they are found.
+		/// The reader may close the result queue at any time; the search
+		/// then stops. The queue is left open when the search finishes;
+		/// closing it is up to the caller.
+		bool streaming;
+
+		/// Keep only the `top_k` results with the highest `score`,
+		/// instead of all of them. The score is an executable Atom,
+		/// with (some of) the pattern variables free in it; it is
+		/// grounded and executed for each grounding of the pattern, and
+		/// must give a number. Results are delivered best-first, when
+		/// the search is done; use a QueueValue to hold them, so that
+		/// this order is kept. A result found more than once keeps its
+		/// highest score. Zero, the default, keeps all results.
+		///
+		/// If the score depends on the groundings only through the term
+		/// that the search starts from (as it does for, e.g.
+		/// `(FloatValueOf <clause> <key>)`, when the search starts at
+		/// that clause), then the search goes best-first, and stops as
+		/// soon as the top results are final.
+		size_t top_k;
+		Handle score;
+
 		virtual void set_pattern(const Variables& vars,
 		                         const Pattern& pat)
 		{
@@ -90,6 +132,9 @@ class RewriteMixin :
 		virtual bool propose_grounding(const GroundingMap &var_soln,
 		                               const GroundingMap &term_soln);
 
+		virtual double candidate_bound(const Handle&, const Handle&);
+		virtual double score_to_beat(void) { return _cutoff; }
+
 		virtual bool start_search(void);
 		virtual bool search_finished(bool);
 };
@@ -129,6 +129,12 @@ class SatisfyingSet :
 			return ContinuationMixin::satisfy(plp);
 		}
 
+		// Continuations are thrown out of evaluatable clauses, and
+		// are not thread-safe. Otherwise, a parallel search is OK.
+		virtual bool is_thread_safe(void) {
+			return not _pattern->have_evaluatables;
+		}
+
 		// Return true if a satisfactory grounding has been
 		// found. Note that in case where you want all possible
 		// groundings, this will usually return false, so the
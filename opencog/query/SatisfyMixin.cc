@@ -95,6 +95,11 @@ class PMCGroundings : public SatisfyMixin
 		{
 			return _cb.get_incoming_set(h, t);
 		}
+		IncomingSet get_incoming_by_position(const Handle& h, Type t,
+		                                     Arity arity, Arity pos)
+		{
+			return _cb.get_incoming_by_position(h, t, arity, pos);
+		}
 		Handle get_link(const Handle& hg, Type t, HandleSeq&& oset)
 		{
 			return _cb.get_link(hg, t, std::move(oset));
@@ -129,6 +134,16 @@ class PMCGroundings : public SatisfyMixin
 			return _cb.search_finished(done);
 		}
 
+		bool is_thread_safe(void)
+		{
+			return _cb.is_thread_safe();
+		}
+
+		void setup_workers(size_t nworkers)
+		{
+			_cb.setup_workers(nworkers);
+		}
+
 		// This one we don't pass through. Instead, we collect the
 		// groundings.
 		bool propose_grounding(const GroundingMap &var_soln,
@@ -0,0 +1,136 @@
+/*
+ * opencog/query/SearchPool.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Persistent thread pool for fanning out the pattern search loop.
+ */
+
+#include "SearchPool.h"
+
+using namespace opencog;
+
+thread_local size_t SearchPool::_worker_id = 0;
+
+SearchPool& SearchPool::instance(void)
+{
+	static SearchPool pool;
+	return pool;
+}
+
+SearchPool::SearchPool(void) :
+	_job(nullptr),
+	_nworkers(0),
+	_generation(0),
+	_pending(0),
+	_shutdown(false)
+{
+}
+
+SearchPool::~SearchPool()
+{
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_shutdown = true;
+	}
+	_start_cv.notify_all();
+	for (std::thread& t : _threads)
+		t.join();
+}
+
+/// Make sure that there are at least `nthreads` pool threads.
+/// Must be called with `_run_mtx` held, so that no job is running.
+void SearchPool::grow(size_t nthreads)
+{
+	while (_threads.size() < nthreads)
+	{
+		size_t wid = _threads.size() + 1;
+		_threads.emplace_back(&SearchPool::worker_loop, this,
+		                      wid, _generation);
+	}
+}
+
+// The generation is passed in, rather than read here, as the new
+// thread might not start running until after the job is posted.
+void SearchPool::worker_loop(size_t wid, size_t seen)
+{
+	_worker_id = wid;
+
+	std::unique_lock<std::mutex> lck(_mtx);
+	while (true)
+	{
+		_start_cv.wait(lck, [&]{ return _shutdown or seen != _generation; });
+		if (_shutdown) return;
+		seen = _generation;
+
+		// Not needed for this job; go back to sleep.
+		if (_nworkers <= wid) continue;
+
+		const Job* job = _job;
+		lck.unlock();
+		try
+		{
+			(*job)(wid);
+		}
+		catch (...)
+		{
+			lck.lock();
+			if (nullptr == _error) _error = std::current_exception();
+			lck.unlock();
+		}
+		lck.lock();
+		if (0 == --_pending) _done_cv.notify_all();
+	}
+}
+
+bool SearchPool::run(size_t nworkers, const Job& job)
+{
+	// Nested parallelism would deadlock, waiting on ourselves.
+	if (in_worker()) return false;
+
+	std::unique_lock<std::mutex> run_lck(_run_mtx, std::try_to_lock);
+	if (not run_lck.owns_lock()) return false;
+
+	if (nworkers < 2)
+	{
+		job(0);
+		return true;
+	}
+
+	grow(nworkers - 1);
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		_job = &job;
+		_nworkers = nworkers;
+		_pending = nworkers - 1;
+		_error = nullptr;
+		_generation++;
+	}
+	_start_cv.notify_all();
+
+	// The caller does its share of the work, too.
+	try
+	{
+		job(0);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lck(_mtx);
+		if (nullptr == _error) _error = std::current_exception();
+	}
+
+	std::exception_ptr err;
+	{
+		std::unique_lock<std::mutex> lck(_mtx);
+		_done_cv.wait(lck, [&]{ return 0 == _pending; });
+		_job = nullptr;
+		err = _error;
+		_error = nullptr;
+	}
+
+	if (err) std::rethrow_exception(err);
+	return true;
+}
+
+/* ===================== END OF FILE ===================== */
@@ -0,0 +1,96 @@
+/*
+ * opencog/query/SearchPool.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Persistent thread pool for fanning out the pattern search loop.
+ */
+
+#ifndef _OPENCOG_SEARCH_POOL_H
+#define _OPENCOG_SEARCH_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace opencog
+{
+
+/**
+ * SearchPool - a process-wide pool of worker threads, used by
+ * `InitiateSearchMixin::search_loop()` to explore the starting
+ * candidates of a search in parallel.
+ *
+ * Creating threads is expensive compared to a typical small search,
+ * so the threads are created once, on first use, and then parked on
+ * a condition variable between searches.
+ *
+ * The `run()` method executes a job on N workers at once. The calling
+ * thread always takes part, as worker zero; the pool supplies workers
+ * 1 through N-1. Each worker knows its own index via `worker_id()`,
+ * which can be used to pick out per-thread search state.
+ *
+ * Only one job runs at a time. A nested request (e.g. a query that is
+ * run from inside of a worker, while evaluating some clause) or a
+ * request made while the pool is busy with some other search does not
+ * wait; `run()` returns false, and the caller should fall back to
+ * a plain sequential loop.
+ */
+class SearchPool
+{
+public:
+	typedef std::function<void(size_t)> Job;
+
+	static SearchPool& instance(void);
+
+	/// Run `job(wid)` on `nworkers` threads, including the caller,
+	/// and wait for all of them to finish. If any of the workers
+	/// throws, the first exception is rethrown here, in the caller.
+	/// Returns false, without running anything, if the pool is
+	/// already busy, or if called from a worker thread.
+	bool run(size_t nworkers, const Job& job);
+
+	/// Index of the current thread within the running job. Zero for
+	/// the thread that called `run()`, and for all non-pool threads.
+	static size_t worker_id(void) { return _worker_id; }
+
+	/// True if the current thread belongs to the pool.
+	static bool in_worker(void) { return 0 != _worker_id; }
+
+	/// Number of threads created so far, not counting callers.
+	size_t size(void) const { return _threads.size(); }
+
+	~SearchPool();
+
+private:
+	SearchPool(void);
+	void grow(size_t);
+	void worker_loop(size_t, size_t);
+
+	static thread_local size_t _worker_id;
+
+	std::vector<std::thread> _threads;
+
+	// One job at a time.
+	std::mutex _run_mtx;
+
+	// Guards everything below.
+	std::mutex _mtx;
+	std::condition_variable _start_cv;
+	std::condition_variable _done_cv;
+
+	const Job* _job;
+	size_t _nworkers;
+	size_t _generation;
+	size_t _pending;
+	bool _shutdown;
+	std::exception_ptr _error;
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_SEARCH_POOL_H
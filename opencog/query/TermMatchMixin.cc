@@ -28,6 +28,7 @@
 #include <opencog/atoms/free/Replacement.h>
 #include <opencog/atoms/grant/StateLink.h>
 
+#include "SearchPool.h"
 #include "TermMatchMixin.h"
 
 using namespace opencog;
@@ -70,7 +71,7 @@ Set set_intersection(const Set& s1, const Set& s2)
 TermMatchMixin::TermMatchMixin(AtomSpace* as) :
 	_nameserver(nameserver())
 {
-	_temp_aspace = createAtomSpace(AtomSpaceCast(as));
+	_term_state.temp_aspace = createAtomSpace(AtomSpaceCast(as));
 
 	_connectives.insert(SEQUENTIAL_AND_LINK);
 	_connectives.insert(SEQUENTIAL_OR_LINK);
@@ -79,8 +80,6 @@ TermMatchMixin::TermMatchMixin(AtomSpace* as) :
 	_connectives.insert(NOT_LINK);
 
 	_as = as;
-	_pat_bound_vars = nullptr;
-	_gnd_bound_vars = nullptr;
 }
 
 TermMatchMixin::~TermMatchMixin()
@@ -89,6 +88,30 @@ TermMatchMixin::~TermMatchMixin()
 	// when the shared_ptr goes out of scope.
 }
 
+/// Return the matching state for the current thread. The per-worker
+/// states exist only while a parallel search is running.
+TermMatchMixin::TermState& TermMatchMixin::term_state(void)
+{
+	if (_worker_term_state.empty()) return _term_state;
+	return _worker_term_state[SearchPool::worker_id()];
+}
+
+/// The temp atomspaces for the workers are created on first use;
+/// most searches never need them.
+AtomSpace* TermMatchMixin::temp_aspace(void)
+{
+	TermState& ts = term_state();
+	if (nullptr == ts.temp_aspace)
+		ts.temp_aspace = createAtomSpace(AtomSpaceCast(_as));
+	return ts.temp_aspace.get();
+}
+
+void TermMatchMixin::setup_workers(size_t nworkers)
+{
+	_worker_term_state.clear();
+	_worker_term_state.resize(nworkers);
+}
+
 /* ======================================================== */
 
 /**
@@ -134,12 +157,13 @@ bool TermMatchMixin::variable_match(const Handle& npat_h,
 bool TermMatchMixin::scope_match(const Handle& npat_h,
                                  const Handle& nsoln_h)
 {
+	TermState& ts = term_state();
 	// If there are scoped vars, then accept anything that is
 	// alpha-equivalent. (i.e. equivalent after alpha-conversion)
-	if (_pat_bound_vars and _pat_bound_vars->varset_contains(npat_h))
+	if (ts.pat_bound_vars and ts.pat_bound_vars->varset_contains(npat_h))
 	{
-		bool aok = _pat_bound_vars->is_alpha_convertible(npat_h,
-		                  nsoln_h, *_gnd_bound_vars);
+		bool aok = ts.pat_bound_vars->is_alpha_convertible(npat_h,
+		                  nsoln_h, *ts.gnd_bound_vars);
 		return aok;
 	}
 
@@ -162,6 +186,7 @@ bool TermMatchMixin::scope_match(const Handle& npat_h,
 bool TermMatchMixin::link_match(const PatternTermPtr& ptm,
                                 const Handle& lsoln)
 {
+	TermState& ts = term_state();
 	const Handle& lpat = ptm->getHandle();
 
 	// If the pattern is exactly the same link as the proposed
@@ -192,24 +217,24 @@ bool TermMatchMixin::link_match(const PatternTermPtr& ptm,
 		// scoped links. The correct fix would be to push these onto a
 		// stack, and then alter scope_match() to walk the stack,
 		// verifying alpha-convertability.
-		OC_ASSERT(nullptr == _pat_bound_vars,
+		OC_ASSERT(nullptr == ts.pat_bound_vars,
 			"Not implemented! Need to implement a stack, here.");
-		_pat_bound_vars = & ScopeLinkCast(lpat)->get_variables();
-		_gnd_bound_vars = & ScopeLinkCast(lsoln)->get_variables();
+		ts.pat_bound_vars = & ScopeLinkCast(lpat)->get_variables();
+		ts.gnd_bound_vars = & ScopeLinkCast(lsoln)->get_variables();
 
 		// This is interesting: the ground term need only satisfy
 		// the pattern typing requirements.  We do not ask for equality:
-		//     if (not _pat_bound_vars->is_equal(*_gnd_bound_vars))
+		//     if (not ts.pat_bound_vars->is_equal(*ts.gnd_bound_vars))
 		// because that prevents searches for narrowly-typed grounds
 		// (as is done in the ForwardChainerUTest, see bug #934)
 		// Alternately, a single variable can match an entire
 		// VariableList (per bug #2070).
-		if (not (*_pat_bound_vars == *_gnd_bound_vars)
-		      and not _pat_bound_vars->is_type(VARIABLE_LIST)
-		      and not _pat_bound_vars->is_type(_gnd_bound_vars->varseq))
+		if (not (*ts.pat_bound_vars == *ts.gnd_bound_vars)
+		      and not ts.pat_bound_vars->is_type(VARIABLE_LIST)
+		      and not ts.pat_bound_vars->is_type(ts.gnd_bound_vars->varseq))
 		{
-			_pat_bound_vars = nullptr;
-			_gnd_bound_vars = nullptr;
+			ts.pat_bound_vars = nullptr;
+			ts.gnd_bound_vars = nullptr;
 			return false;
 		}
 		return true;
@@ -222,11 +247,12 @@ bool TermMatchMixin::link_match(const PatternTermPtr& ptm,
 bool TermMatchMixin::post_link_match(const Handle& lpat,
                                      const Handle& lgnd)
 {
+	TermState& ts = term_state();
 	Type pattype = lpat->get_type();
-	if (_pat_bound_vars and _nameserver.isA(pattype, SCOPE_LINK))
+	if (ts.pat_bound_vars and _nameserver.isA(pattype, SCOPE_LINK))
 	{
-		_pat_bound_vars = nullptr;
-		_gnd_bound_vars = nullptr;
+		ts.pat_bound_vars = nullptr;
+		ts.gnd_bound_vars = nullptr;
 	}
 
 	// The StateLink has a single, unique closed-term value (or possibly
@@ -245,11 +271,12 @@ bool TermMatchMixin::post_link_match(const Handle& lpat,
 void TermMatchMixin::post_link_mismatch(const Handle& lpat,
                                         const Handle& lgnd)
 {
+	TermState& ts = term_state();
 	Type pattype = lpat->get_type();
-	if (_pat_bound_vars and _nameserver.isA(pattype, SCOPE_LINK))
+	if (ts.pat_bound_vars and _nameserver.isA(pattype, SCOPE_LINK))
 	{
-		_pat_bound_vars = nullptr;
-		_gnd_bound_vars = nullptr;
+		ts.pat_bound_vars = nullptr;
+		ts.gnd_bound_vars = nullptr;
 	}
 }
 
@@ -409,8 +436,9 @@ bool TermMatchMixin::clause_match(const Handle& ptrn,
 		// further grounding. This actually seems reasonable. The second
 		// assumption is that the EvaluationLink is actually evaluatable,
 		// which seems reasonable.
-		_temp_aspace->clear();
-		bool crispy = grnd->bevaluate(_temp_aspace.get());
+		AtomSpace* tas = temp_aspace();
+		tas->clear();
+		bool crispy = grnd->bevaluate(tas);
 
 		DO_LOG({LAZY_LOG_FINE << "Clause_match evaluation yielded: "
 		                      << crispy << std::endl;})
@@ -487,6 +515,19 @@ IncomingSet TermMatchMixin::get_incoming_set(const Handle& h, Type t)
 	return h->getIncomingSetByType(t, _as);
 }
 
+/// Use the position index, if the AtomSpace has one for this type.
+/// See `AtomSpace::index_positions()`.
+IncomingSet TermMatchMixin::get_incoming_by_position(const Handle& h,
+                                                     Type t,
+                                                     Arity arity,
+                                                     Arity pos)
+{
+	IncomingSet iset;
+	if (_as and _as->get_incoming_by_position(iset, h, t, pos, arity))
+		return iset;
+	return get_incoming_set(h, t);
+}
+
 Handle TermMatchMixin::get_link(const Handle& hg,
                                 Type t, HandleSeq&& oset)
 {
@@ -512,9 +553,10 @@ bool TermMatchMixin::eval_term(const Handle& virt,
 	DO_LOG({LAZY_LOG_FINE << "Grounded by gvirt=" << std::endl
 	              << gvirt->to_short_string() << std::endl;})
 
-	_temp_aspace->clear();
+	AtomSpace* tas = temp_aspace();
+	tas->clear();
 
-	bool crispy = gvirt->bevaluate(_temp_aspace.get(), true);
+	bool crispy = gvirt->bevaluate(tas, true);
 	DO_LOG({LAZY_LOG_FINE << "Eval_term evaluation yielded crisp-tv="
 	                      << crispy << std::endl;})
 	return crispy;
@@ -25,6 +25,7 @@
 #ifndef _OPENCOG_TERM_MATCH_MIXIN_H
 #define _OPENCOG_TERM_MATCH_MIXIN_H
 
+#include <atomic>
 #include <opencog/atoms/atom_types/types.h>
 #include <opencog/atoms/free/Quotation.h>
 #include <opencog/atomspace/AtomSpace.h>
@@ -78,6 +79,8 @@ class TermMatchMixin : public virtual PatternMatchCallback
 		                                 const GroundingMap&);
 
 		virtual IncomingSet get_incoming_set(const Handle&, Type);
+		virtual IncomingSet get_incoming_by_position(const Handle&, Type,
+		                                             Arity, Arity);
 		virtual Handle get_link(const Handle&, Type, HandleSeq&&);
 
 		/**
@@ -92,6 +95,8 @@ class TermMatchMixin : public virtual PatternMatchCallback
 			return _connectives;
 		}
 
+		virtual void setup_workers(size_t);
+
 		bool optionals_present(void) { return _optionals_present; }
 
 	protected:
@@ -101,21 +106,30 @@ class TermMatchMixin : public virtual PatternMatchCallback
 		                    const GroundingMap&, const HandleSet&,
 		                    Quotation quotation=Quotation());
 
-		// Variables that should be ignored, because they are bound
-		// (scoped) in the current context (i.e. appear in a ScopeLink
-		// that is being matched.)
-		const Variables* _pat_bound_vars;
-		const Variables* _gnd_bound_vars;
-
-		// Temp atomspace used for test-groundings of virtual links.
-		AtomSpacePtr _temp_aspace;
+		// Matching state. There is one of these for a single-threaded
+		// search, and one per worker, during a parallel search.
+		struct TermState
+		{
+			// Variables that should be ignored, because they are bound
+			// (scoped) in the current context (i.e. appear in a ScopeLink
+			// that is being matched.)
+			const Variables* pat_bound_vars = nullptr;
+			const Variables* gnd_bound_vars = nullptr;
+
+			// Temp atomspace used for test-groundings of virtual links.
+			AtomSpacePtr temp_aspace;
+		};
+		TermState _term_state;
+		std::vector<TermState> _worker_term_state;
+		TermState& term_state(void);
+		AtomSpace* temp_aspace(void);
 
 		// Crisp-logic evaluation of evaluatable terms
 		TypeSet _connectives;
 		bool eval_term(const Handle& pat, const GroundingMap& gnds);
 		bool eval_sentence(const Handle& pat, const GroundingMap& gnds);
 
-		bool _optionals_present = false;
+		std::atomic<bool> _optionals_present{false};
 		AtomSpace* _as;
 };
 
@@ -0,0 +1,140 @@
+/*
+ * opencog/query/TrailMap.h
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * A map that can be rolled back to earlier states.
+ */
+
+#ifndef _OPENCOG_TRAIL_MAP_H
+#define _OPENCOG_TRAIL_MAP_H
+
+#include <utility>
+#include <vector>
+
+namespace opencog
+{
+
+/**
+ * TrailMap - a map, together with a trail (an undo log) of the changes
+ * made to it. `mark()` remembers the current state; `undo()` rolls all
+ * changes back to the last mark, and `drop()` forgets the last mark,
+ * but keeps the changes.
+ *
+ * This is used by the PatternMatchEngine for backtracking. It replaces
+ * stacks of copies of the whole map: pushing a copy takes time and
+ * memory in proportion to the size of the map, while the trail holds
+ * only the entries that were actually changed. Changes made while
+ * there are no marks are not recorded at all.
+ *
+ * All changes must go through `operator[]`, `erase()` or `clear()`;
+ * this is why only const iterators are handed out. The reference
+ * returned by `operator[]` should be assigned to right away, and not
+ * held on to.
+ */
+template<typename Map>
+class TrailMap
+{
+public:
+	typedef typename Map::key_type key_type;
+	typedef typename Map::mapped_type mapped_type;
+	typedef typename Map::const_iterator const_iterator;
+
+	operator const Map&() const { return _map; }
+	const Map& map(void) const { return _map; }
+
+	const_iterator begin(void) const { return _map.begin(); }
+	const_iterator end(void) const { return _map.end(); }
+	const_iterator find(const key_type& k) const { return _map.find(k); }
+	size_t count(const key_type& k) const { return _map.count(k); }
+	size_t size(void) const { return _map.size(); }
+	bool empty(void) const { return _map.empty(); }
+
+	mapped_type& operator[](const key_type& k)
+	{
+		save(k);
+		return _map[k];
+	}
+
+	size_t erase(const key_type& k)
+	{
+		save(k);
+		return _map.erase(k);
+	}
+
+	const_iterator erase(const_iterator it)
+	{
+		save(it->first);
+		return _map.erase(it);
+	}
+
+	/// Empty the map, and forget all marks.
+	void clear(void)
+	{
+		_map.clear();
+		_trail.clear();
+		_marks.clear();
+	}
+
+	/// Remember the current state.
+	void mark(void) { _marks.push_back(_trail.size()); }
+
+	/// Go back to the state at the last mark, and forget that mark.
+	void undo(void)
+	{
+		size_t m = _marks.back();
+		_marks.pop_back();
+		while (m < _trail.size())
+		{
+			Undo& u = _trail.back();
+			if (u.had)
+				_map[u.key] = std::move(u.old);
+			else
+				_map.erase(u.key);
+			_trail.pop_back();
+		}
+	}
+
+	/// Forget the last mark, keeping all changes made since then.
+	void drop(void)
+	{
+		_marks.pop_back();
+		if (_marks.empty()) _trail.clear();
+	}
+
+	/// Forget all marks, keeping all changes.
+	void forget(void)
+	{
+		_trail.clear();
+		_marks.clear();
+	}
+
+	size_t depth(void) const { return _marks.size(); }
+
+private:
+	struct Undo
+	{
+		key_type key;
+		bool had;
+		mapped_type old;
+	};
+
+	Map _map;
+	std::vector<Undo> _trail;
+	std::vector<size_t> _marks;
+
+	void save(const key_type& k)
+	{
+		if (_marks.empty()) return;
+		const auto& it = _map.find(k);
+		if (_map.end() == it)
+			_trail.push_back({k, false, mapped_type()});
+		else
+			_trail.push_back({k, true, it->second});
+	}
+};
+
+} // namespace opencog
+
+#endif // _OPENCOG_TRAIL_MAP_H
@@ -50,6 +50,7 @@ cog-atomspace-env
 cog-atomspace-readonly?
 cog-atomspace-ro!
 cog-atomspace-rw!
+cog-atomspace-squash
 cog-count-atoms
 cog-equal?
 cog-get-subtypes
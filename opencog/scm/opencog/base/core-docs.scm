@@ -804,6 +804,34 @@
        cog-atomspace -- Get the current AtomSpace in this thread.
 ")
 
+(set-procedure-property! cog-atomspace-squash 'documentation
+"
+ cog-atomspace-squash BOTTOM TOP [ATOMSPACE]
+    Squash the frames from BOTTOM up to TOP into a single frame, in
+    the manner of squashing commits in git. Both BOTTOM and TOP must
+    be in the stack of frames underneath ATOMSPACE (or be ATOMSPACE),
+    with BOTTOM at or below TOP. The ATOMSPACE argument is optional;
+    if not specified, the current atomspace is assumed.
+
+    Returns a new copy of ATOMSPACE. Underneath it, the frames above
+    TOP are copied, one for one; the run is replaced by one frame, and
+    the frames below BOTTOM are shared. Each of these frames sees the
+    same Atoms and Values as the one it replaces; Atoms deleted in the
+    run remain deleted. The old stack is left as it was.
+
+    Example:
+       ; A stack of four frames; squash the middle two together.
+       (define a (cog-new-atomspace))
+       (define b (cog-new-atomspace a))
+       (define c (cog-new-atomspace b))
+       (define d (cog-new-atomspace c))
+       (define new-d (cog-atomspace-squash b c d))
+       (cog-atomspace-env (car (cog-atomspace-env new-d)))  ; => (a)
+
+    See also:
+       cog-atomspace-env -- Get the subspaces.
+")
+
 (set-procedure-property! cog-push-atomspace 'documentation
 "
  cog-push-atomspace -- Create a temporary AtomSpace.
@@ -248,5 +248,40 @@
 
 (test-end istack)
 
+; -------------------------------------------------------------------
+; Squash the middle of the stack into one frame. The frames above it
+; are copied, and see the same values as before.
+
+(define sstack "squash stack")
+(test-begin sstack)
+
+(define new-top (cog-atomspace-squash
+	(list-ref space-list 5) (list-ref space-list 15) (last space-list)))
+
+; The frame in the new stack that stands in for frame N of the old.
+(define (new-frame N)
+	(if (eq? N num-spaces) new-top
+		(car (cog-atomspace-env (new-frame (+ N 1))))))
+
+(define (hello-count space)
+	(cog-set-atomspace! space)
+	(inexact->exact (cog-value-ref
+		(cog-value (Concept "hello") (Predicate "*-TruthValueKey-*")) 2)))
+
+(for-each (lambda (n)
+		(test-equal "squash-count" n (hello-count (new-frame n)))
+		(test-assert "squash-copy"
+			(not (equal? (new-frame n) (list-ref space-list n)))))
+	(iota 6 15))
+
+(test-equal "squash-parent" (list-ref space-list 4)
+	(car (cog-atomspace-env (new-frame 15))))
+
+; The old stack is as it was.
+(test-equal "squash-old" num-spaces (hello-count (last space-list)))
+(test-equal "squash-old-mid" 10 (hello-count (list-ref space-list 10)))
+
+(test-end sstack)
+
 ; -------------------------------------------------------------------
 (opencog-test-end)
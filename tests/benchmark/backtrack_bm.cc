@@ -0,0 +1,166 @@
+/*
+ * tests/benchmark/backtrack_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Pattern matcher benchmark for queries that backtrack a lot: pairs
+ * of unordered links sharing variables (as in the unordered-odo-*
+ * tests), and globs, which can be grounded in many ways. The time
+ * goes into saving and restoring the search state.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include <opencog/atoms/pattern/QueryLink.h>
+#include <opencog/atoms/value/QueueValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+#include <opencog/query/Implicator.h>
+
+using namespace opencog;
+
+struct Params
+{
+	size_t nlinks;
+	size_t nwords;
+	double seconds;
+};
+
+static Handle word(AtomSpace* as, size_t i)
+{
+	return as->add_node(CONCEPT_NODE, "word-" + std::to_string(i));
+}
+
+// Two SetLinks with two members in common:
+//
+//    (Evaluation (Predicate "odo")
+//       (List (Set a b c d) (Set c d e f)))
+//
+static Handle odo_setup(AtomSpace* as, const Params& p)
+{
+	std::minstd_rand rng(42);
+	Handle odo(as->add_node(PREDICATE_NODE, "odo"));
+	for (size_t i = 0; i < p.nlinks; i++)
+	{
+		HandleSeq w;
+		for (int k = 0; k < 6; k++) w.push_back(word(as, rng() % p.nwords));
+		as->add_link(EVALUATION_LINK, odo,
+			as->add_link(LIST_LINK,
+				as->add_link(SET_LINK, w[0], w[1], w[2], w[3]),
+				as->add_link(SET_LINK, w[2], w[3], w[4], w[5])));
+	}
+
+	HandleSeq v;
+	for (const char* n : {"$a", "$b", "$c", "$d", "$e", "$f"})
+		v.push_back(createNode(VARIABLE_NODE, n));
+
+	return createLink(QUERY_LINK,
+		createLink(HandleSeq(v), VARIABLE_LIST),
+		createLink(EVALUATION_LINK, odo,
+			createLink(LIST_LINK,
+				createLink(SET_LINK, v[0], v[1], v[2], v[3]),
+				createLink(SET_LINK, v[2], v[3], v[4], v[5]))),
+		createLink(LIST_LINK, v[0], v[5]));
+}
+
+// Long ListLinks of words, and a pattern with three globs:
+//
+//    (List $g1 word-0 $g2 word-1 $g3)
+//
+static Handle glob_setup(AtomSpace* as, const Params& p)
+{
+	std::minstd_rand rng(43);
+	for (size_t i = 0; i < p.nlinks; i++)
+	{
+		HandleSeq w;
+		for (int k = 0; k < 12; k++) w.push_back(word(as, rng() % p.nwords));
+		w.push_back(word(as, 0));
+		w.push_back(word(as, 1));
+		as->add_link(LIST_LINK, std::move(w));
+	}
+
+	Handle g1(createNode(GLOB_NODE, "$g1"));
+	Handle g2(createNode(GLOB_NODE, "$g2"));
+	Handle g3(createNode(GLOB_NODE, "$g3"));
+	return createLink(QUERY_LINK,
+		createLink(VARIABLE_LIST, g1, g2, g3),
+		createLink(HandleSeq({g1, word(as, 0), g2, word(as, 1), g3}),
+		           LIST_LINK),
+		createLink(LIST_LINK, g1, g2, g3));
+}
+
+// Count the groundings, without building any results; the time spent
+// in rewriting and de-duplicating them would swamp the search.
+class Counter : public Implicator
+{
+	public:
+		size_t count;
+		Counter(AtomSpace* as, ContainerValuePtr& cvp) :
+			Implicator(as, cvp), count(0) {}
+
+		virtual bool propose_grounding(const GroundingMap&,
+		                               const GroundingMap&)
+		{
+			count++;
+			return false;
+		}
+		virtual bool is_thread_safe(void) { return false; }
+};
+
+static size_t run_query(AtomSpace* as, const Handle& query)
+{
+	ContainerValuePtr cvp(createQueueValue());
+	Counter cnt(as, cvp);
+	cnt.satisfy(QueryLinkCast(query));
+	return cnt.count;
+}
+
+static void run(const char* name, const Params& p,
+                Handle (*setup)(AtomSpace*, const Params&))
+{
+	AtomSpacePtr asp(createAtomSpace());
+	AtomSpace* as = asp.get();
+	Handle query(setup(as, p));
+
+	size_t nres = 0;
+	size_t nruns = 0;
+	auto start = std::chrono::steady_clock::now();
+	auto end = start;
+	double secs = 0.0;
+	while (secs < p.seconds)
+	{
+		nres = run_query(as, query);
+		nruns++;
+		end = std::chrono::steady_clock::now();
+		secs = std::chrono::duration<double>(end - start).count();
+	}
+
+	printf("%-6s %8zu groundings  %10.3f millisecs/query\n",
+	       name, nres, 1000.0 * secs / nruns);
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [links [words [seconds]]]\n", argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.nlinks = 1000;
+	p.nwords = 8;
+	p.seconds = 3.0;
+	if (1 < argc) p.nlinks = atol(argv[1]);
+	if (2 < argc) p.nwords = atol(argv[2]);
+	if (3 < argc) p.seconds = atof(argv[3]);
+
+	printf("%zu links, over %zu words\n", p.nlinks, p.nwords);
+	run("odo", p, odo_setup);
+	run("glob", p, glob_setup);
+	return 0;
+}
@@ -0,0 +1,134 @@
+/*
+ * tests/benchmark/deep_space_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Deep stacks of AtomSpace frames, as in deep-space-test.scm: each
+ * frame changes the Value on a shared Atom, adds an Atom of its own,
+ * and, now and then, hides an Atom from the base. Times the building
+ * of the stack, and then lookups, depth() and in_environ() made from
+ * the top of it.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+#define NBASE 1000
+
+typedef std::chrono::steady_clock Clock;
+
+static double usecs_since(Clock::time_point start)
+{
+	return 1.0e6 * std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Run `fn` over and over, for about `seconds`; return usecs per call.
+template<typename F>
+static double time_it(double seconds, F fn)
+{
+	size_t n = 0;
+	auto start = Clock::now();
+	double us = 0.0;
+	while (us < 1.0e6 * seconds)
+	{
+		for (int i = 0; i < 100; i++) fn(n++);
+		us = usecs_since(start);
+	}
+	return us / n;
+}
+
+static void run(size_t nlayers, double seconds)
+{
+	AtomSpacePtr base(createAtomSpace());
+	for (size_t i = 0; i < NBASE; i++)
+		base->add_node(CONCEPT_NODE, "base-" + std::to_string(i));
+	Handle foo(base->add_node(CONCEPT_NODE, "foo"));
+	Handle key(base->add_node(PREDICATE_NODE, "key"));
+
+	// Each frame has a different Value on foo; every tenth one hides
+	// an Atom of the base.
+	auto start = Clock::now();
+	AtomSpacePtr top(base);
+	for (size_t l = 1; l <= nlayers; l++)
+	{
+		top = createAtomSpace(top);
+		top->set_value(foo, key, createFloatValue((double) l));
+		top->add_node(CONCEPT_NODE, "layer-" + std::to_string(l));
+		if (0 == l % 10)
+			top->extract_atom(createNode(CONCEPT_NODE,
+				"base-" + std::to_string(l / 10 % NBASE)));
+	}
+	double build = usecs_since(start) / nlayers;
+
+	Handle mid(createNode(CONCEPT_NODE, "layer-" + std::to_string(nlayers/2)));
+	Handle missing(createNode(CONCEPT_NODE, "no such thing"));
+	HandleSeq bases;
+	for (size_t i = 0; i < NBASE; i++)
+		bases.push_back(createNode(CONCEPT_NODE, "base-" + std::to_string(i)));
+
+	size_t found = 0;
+	double t_foo = time_it(seconds, [&](size_t) {
+		if (top->get_atom(foo)) found++; });
+	double t_base = time_it(seconds, [&](size_t n) {
+		if (top->get_atom(bases[n % NBASE])) found++; });
+	double t_mid = time_it(seconds, [&](size_t) {
+		if (top->get_atom(mid)) found++; });
+	double t_miss = time_it(seconds, [&](size_t) {
+		if (top->get_atom(missing)) found++; });
+	int deep = 0;
+	double t_depth = time_it(seconds, [&](size_t) {
+		deep = top->depth(base.get()); });
+	double t_env = time_it(seconds, [&](size_t) {
+		if (top->in_environ(base.get())) found++; });
+
+	// Sanity check: the top sees its own Value on foo.
+	Handle hf(top->get_atom(foo));
+	FloatValuePtr fv(FloatValueCast(hf->getValue(key)));
+	if (nullptr == fv or fv->value()[0] != (double) nlayers or
+	    (int) nlayers != deep)
+	{
+		fprintf(stderr, "Error: wrong answers at %zu layers\n", nlayers);
+		exit(1);
+	}
+
+	printf("%6zu layers  %8.2f  %8.3f  %8.3f  %8.3f  %8.3f  %8.3f  %8.3f\n",
+	       nlayers, build, t_foo, t_base, t_mid, t_miss, t_depth, t_env);
+
+	// Unwind from the top, so that the teardown is not recursive.
+	while (top != base)
+	{
+		AtomSpacePtr below(AtomSpaceCast(top->getOutgoingAtom(0)));
+		top = below;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [seconds [layers...]]\n", argv[0]);
+		return 0;
+	}
+
+	double seconds = 0.5;
+	if (1 < argc) seconds = atof(argv[1]);
+
+	std::vector<size_t> layers;
+	for (int i = 2; i < argc; i++) layers.push_back(atol(argv[i]));
+	if (layers.empty()) layers = {10, 1000, 10000};
+
+	printf("Microseconds per operation; build is per layer.\n");
+	printf("%6s layers  %8s  %8s  %8s  %8s  %8s  %8s  %8s\n", "",
+	       "build", "top", "base", "middle", "missing", "depth", "environ");
+	for (size_t n : layers)
+		run(n, seconds);
+	return 0;
+}
@@ -0,0 +1,166 @@
+/*
+ * tests/benchmark/float_arith_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Point-wise arithmetic on long FloatValues: the vector kernels used
+ * by PlusLink, TimesLink and AccumulateLink, against plain loops, and
+ * the fused (Plus (Times a b) c) against doing it in two steps.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include <opencog/atoms/reduct/PlusLink.h>
+#include <opencog/atoms/reduct/TimesLink.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atoms/value/VectorKernels.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+struct Params
+{
+	size_t minlen;
+	size_t maxlen;
+	double seconds;
+};
+
+// Keep the compiler from optimizing away the reference loops.
+static volatile double sink;
+
+// Run `fn` repeatedly for about `secs` seconds; return the time per
+// call, in microseconds.
+template<typename FN>
+static double timeit(double secs, FN fn)
+{
+	size_t nruns = 0;
+	auto start = std::chrono::steady_clock::now();
+	double elapsed = 0.0;
+	while (elapsed < secs)
+	{
+		fn();
+		nruns++;
+		elapsed = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start).count();
+	}
+	return 1.0e6 * elapsed / nruns;
+}
+
+static std::vector<double> randvec(size_t len, unsigned seed)
+{
+	std::minstd_rand rng(seed);
+	std::uniform_real_distribution<double> dist(-1.0, 1.0);
+	std::vector<double> v(len);
+	for (double& x : v) x = dist(rng);
+	return v;
+}
+
+static void report(const char* name, size_t len, double ref, double fast)
+{
+	printf("%-10s %9zu  %12.2f  %12.2f  %6.2fx\n",
+	       name, len, ref, fast, ref / fast);
+}
+
+static void run_kernels(const Params& p, size_t len)
+{
+	std::vector<double> a(randvec(len, 1));
+	std::vector<double> b(randvec(len, 2));
+	std::vector<double> out(len);
+	double secs = p.seconds / 8;
+
+	double ref = timeit(secs, [&]() {
+		for (size_t i = 0; i < len; i++) out[i] = a[i] + b[i];
+		sink = out[len-1];
+	});
+	double fast = timeit(secs, [&]() {
+		vec_plus(out.data(), a.data(), b.data(), len);
+		sink = out[len-1];
+	});
+	report("plus", len, ref, fast);
+
+	ref = timeit(secs, [&]() {
+		for (size_t i = 0; i < len; i++) out[i] = 3.0 * a[i];
+		sink = out[len-1];
+	});
+	fast = timeit(secs, [&]() {
+		vec_times(out.data(), 3.0, a.data(), len);
+		sink = out[len-1];
+	});
+	report("scale", len, ref, fast);
+
+	ref = timeit(secs, [&]() {
+		double s = 0.0;
+		for (size_t i = 0; i < len; i++) s += a[i];
+		sink = s;
+	});
+	fast = timeit(secs, [&]() {
+		sink = vec_sum(a.data(), len);
+	});
+	report("sum", len, ref, fast);
+}
+
+// (Plus (Times A B) C) with all three being FloatValues held in the
+// AtomSpace. The reference is the same thing, in two steps; that is
+// what the PlusLink did, before it was fused.
+static void run_fused(const Params& p, size_t len)
+{
+	AtomSpacePtr asp(createAtomSpace());
+	AtomSpace* as = asp.get();
+
+	Handle key(as->add_node(PREDICATE_NODE, "key"));
+	HandleSeq vals;
+	for (const char* n : {"A", "B", "C"})
+	{
+		Handle h(as->add_node(CONCEPT_NODE, n));
+		as->set_value(h, key, createFloatValue(randvec(len, n[0])));
+		vals.push_back(createLink(FLOAT_VALUE_OF_LINK, h, key));
+	}
+
+	Handle times(createTimesLink(vals[0], vals[1]));
+	Handle fused(createPlusLink(times, vals[2]));
+	Handle prod(createLink(FLOAT_VALUE_OF_LINK,
+		as->add_node(CONCEPT_NODE, "P"), key));
+	Handle unfused(createPlusLink(prod, vals[2]));
+
+	double secs = p.seconds / 4;
+	double ref = timeit(secs, [&]() {
+		as->set_value(prod->getOutgoingAtom(0), key,
+		              times->execute(as, false));
+		sink = FloatValueCast(unfused->execute(as, false))->value()[0];
+	});
+	double fast = timeit(secs, [&]() {
+		sink = FloatValueCast(fused->execute(as, false))->value()[0];
+	});
+	report("a*b+c", len, ref, fast);
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [min-length [max-length [seconds]]]\n", argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.minlen = 1000;
+	p.maxlen = 10000000;
+	p.seconds = 2.0;
+	if (1 < argc) p.minlen = atol(argv[1]);
+	if (2 < argc) p.maxlen = atol(argv[2]);
+	if (3 < argc) p.seconds = atof(argv[3]);
+
+	printf("%-10s %9s  %12s  %12s  %7s\n",
+	       "op", "length", "before usec", "after usec", "speedup");
+	for (size_t len = p.minlen; len <= p.maxlen; len *= 10)
+	{
+		run_kernels(p, len);
+		run_fused(p, len);
+	}
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * tests/benchmark/increment_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Multi-threaded counting benchmark. Many threads increment counts
+ * on Atoms (as the pair-counting pipelines do), and read them back,
+ * while one more thread keeps adding and removing Links, which keeps
+ * the incoming-set locks busy.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atoms/value/FloatValue.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+struct Params
+{
+	size_t natoms;
+	size_t read_permille;
+	double seconds;
+};
+
+static double run(const Params& p, size_t nthreads, AtomSpace* as,
+                  const Handle& key, const HandleSeq& atoms)
+{
+	std::atomic<bool> go(false);
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> total_ops(0);
+
+	auto counter = [&](size_t tid)
+	{
+		std::minstd_rand rng(tid + 1);
+		size_t ops = 0;
+		while (not go.load()) std::this_thread::yield();
+		while (not stop.load(std::memory_order_relaxed))
+		{
+			for (int k = 0; k < 256; k++)
+			{
+				const Handle& h(atoms[rng() % p.natoms]);
+				if (rng() % 1000 < p.read_permille)
+					h->getValue(key);
+				else
+					as->increment_count(h, key, 0, 1.0);
+			}
+			ops += 256;
+		}
+		total_ops += ops;
+	};
+
+	// Churn the incoming sets of the same Atoms.
+	auto churn = [&]()
+	{
+		std::minstd_rand rng(4242);
+		while (not go.load()) std::this_thread::yield();
+		while (not stop.load(std::memory_order_relaxed))
+		{
+			Handle l(as->add_link(LIST_LINK,
+				atoms[rng() % p.natoms], atoms[rng() % p.natoms]));
+			as->extract_atom(l);
+		}
+	};
+
+	std::vector<std::thread> thrs;
+	for (size_t t = 0; t < nthreads; t++)
+		thrs.push_back(std::thread(counter, t));
+	thrs.push_back(std::thread(churn));
+
+	auto start = std::chrono::steady_clock::now();
+	go = true;
+	std::this_thread::sleep_for(std::chrono::duration<double>(p.seconds));
+	stop = true;
+	for (std::thread& t : thrs) t.join();
+	auto end = std::chrono::steady_clock::now();
+
+	double secs = std::chrono::duration<double>(end - start).count();
+	double mops = total_ops / secs / 1.0e6;
+	printf("threads=%-3zu  %8.2f Mops/sec\n", nthreads, mops);
+	return mops;
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [atoms [reads-per-thousand [seconds [threads...]]]]\n",
+		       argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.natoms = 1000;
+	p.read_permille = 100;
+	p.seconds = 2.0;
+	if (1 < argc) p.natoms = atol(argv[1]);
+	if (2 < argc) p.read_permille = atol(argv[2]);
+	if (3 < argc) p.seconds = atof(argv[3]);
+
+	std::vector<size_t> nthreads({1, 8, 64});
+	if (4 < argc)
+	{
+		nthreads.clear();
+		for (int i = 4; i < argc; i++) nthreads.push_back(atol(argv[i]));
+	}
+
+	AtomSpacePtr asp(createAtomSpace());
+	AtomSpace* as = asp.get();
+	Handle key(as->add_node(PREDICATE_NODE, "count"));
+	HandleSeq atoms;
+	for (size_t i = 0; i < p.natoms; i++)
+		atoms.push_back(as->add_node(CONCEPT_NODE, "word " + std::to_string(i)));
+
+	printf("%zu atoms, %zu reads per thousand ops, plus one incoming-set churner\n",
+	       p.natoms, p.read_permille);
+	for (size_t n : nthreads)
+		run(p, n, as, key, atoms);
+
+	// Sanity check: no increments were lost.
+	double sum = 0.0;
+	for (const Handle& h : atoms)
+	{
+		ValuePtr vp(h->getValue(key));
+		if (vp) sum += FloatValueCast(vp)->value()[0];
+	}
+	printf("total count %.0f\n", sum);
+	return 0;
+}
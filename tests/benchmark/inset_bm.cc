@@ -0,0 +1,92 @@
+/*
+ * tests/benchmark/inset_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Memory benchmark for the incoming sets. Loads an AtomSpace shaped
+ * like typical datasets: most Atoms have one to three Links in their
+ * incoming set, of one or two types. Reports the resident memory per
+ * Atom, and the time taken to load, and to walk the incoming sets.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+// Resident set size, in bytes.
+static size_t rss(void)
+{
+	size_t pages = 0, resident = 0;
+	FILE* f = fopen("/proc/self/statm", "r");
+	if (nullptr == f) return 0;
+	if (2 != fscanf(f, "%zu %zu", &pages, &resident)) resident = 0;
+	fclose(f);
+	return resident * sysconf(_SC_PAGESIZE);
+}
+
+static double since(std::chrono::steady_clock::time_point start)
+{
+	auto now = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(now - start).count();
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [atoms]\n", argv[0]);
+		return 0;
+	}
+
+	size_t natoms = 10000000;
+	if (1 < argc) natoms = atol(argv[1]);
+
+	// A third each of Nodes, ListLinks and InheritanceLinks. Each Node
+	// is held by two ListLinks and one InheritanceLink; each ListLink
+	// by one InheritanceLink.
+	size_t n = natoms / 3;
+	AtomSpacePtr as(createAtomSpace());
+	size_t base = rss();
+
+	auto start = std::chrono::steady_clock::now();
+	HandleSeq nodes;
+	nodes.reserve(n);
+	for (size_t i = 0; i < n; i++)
+		nodes.push_back(as->add_node(CONCEPT_NODE, "node " + std::to_string(i)));
+	for (size_t i = 0; i < n; i++)
+	{
+		Handle pr(as->add_link(LIST_LINK, nodes[i], nodes[(i+1) % n]));
+		as->add_link(INHERITANCE_LINK, pr, nodes[(i+2) % n]);
+	}
+	double load = since(start);
+
+	// Release our own references; only the AtomSpace holds the Atoms.
+	HandleSeq().swap(nodes);
+	size_t used = rss() - base;
+	size_t total = as->get_size();
+
+	start = std::chrono::steady_clock::now();
+	size_t edges = 0;
+	HandleSeq all;
+	as->get_handles_by_type(all, NODE, true);
+	for (const Handle& h : all)
+	{
+		edges += h->getIncomingSetSize();
+		edges += h->getIncomingSetByType(LIST_LINK).size();
+	}
+	double walk = since(start);
+
+	printf("sizeof(Node)=%zu sizeof(Link)=%zu\n", sizeof(Node), sizeof(Link));
+	printf("%zu atoms: %.1f bytes/atom; load %.2f secs; walk %.3f secs (%zu edges)\n",
+	       total, ((double) used) / total, load, walk, edges);
+	return 0;
+}
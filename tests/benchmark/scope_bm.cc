@@ -0,0 +1,136 @@
+/*
+ * tests/benchmark/scope_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Adding many rule-like ScopeLinks to the AtomSpace. Each rule is
+ * added several times over, with differently-named variables, so that
+ * most insertions find an alpha-equivalent copy already present. The
+ * time goes to hashing the scopes and comparing them for equality up
+ * to alpha-conversion.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+#include <opencog/atomspace/AtomSpace.h>
+
+using namespace opencog;
+
+struct Params
+{
+	size_t nrules;
+	size_t ncopies;
+};
+
+static Handle var(AtomSpace* as, const char* name, size_t i)
+{
+	return as->add_node(VARIABLE_NODE, name + std::to_string(i));
+}
+
+static Handle concept(AtomSpace* as, const char* name, size_t i)
+{
+	return as->add_node(CONCEPT_NODE, name + std::to_string(i));
+}
+
+// Rule `r`, with the variable names of copy `k`:
+//
+//    (Lambda
+//       (VariableList (TypedVariable $a (Type "ConceptNode")) $b)
+//       (And
+//          (Inheritance $a (Concept "c-r"))
+//          (Lambda $c
+//             (Evaluation (Predicate "p-r") (List $a $b $c)))))
+//
+static Handle lambda_rule(AtomSpace* as, size_t r, size_t k)
+{
+	Handle a(var(as, "$a-", k));
+	Handle b(var(as, "$b-", k));
+	Handle c(var(as, "$c-", k));
+	Handle vdecl(as->add_link(VARIABLE_LIST,
+		as->add_link(TYPED_VARIABLE_LINK, a,
+			as->add_node(TYPE_NODE, "ConceptNode")),
+		b));
+	Handle inner(as->add_link(LAMBDA_LINK, c,
+		as->add_link(EVALUATION_LINK,
+			as->add_node(PREDICATE_NODE, "p-" + std::to_string(r)),
+			as->add_link(LIST_LINK, a, b, c))));
+	return as->add_link(LAMBDA_LINK, vdecl,
+		as->add_link(AND_LINK,
+			as->add_link(INHERITANCE_LINK, a, concept(as, "c-", r)),
+			inner));
+}
+
+//    (Query
+//       (VariableList $a $b)
+//       (And
+//          (Inheritance $a (Concept "c-r"))
+//          (Member $b $a))
+//       (Evaluation (Predicate "p-r") (List $a $b)))
+//
+static Handle query_rule(AtomSpace* as, size_t r, size_t k)
+{
+	Handle a(var(as, "$a-", k));
+	Handle b(var(as, "$b-", k));
+	return as->add_link(QUERY_LINK,
+		as->add_link(VARIABLE_LIST, a, b),
+		as->add_link(AND_LINK,
+			as->add_link(INHERITANCE_LINK, a, concept(as, "c-", r)),
+			as->add_link(MEMBER_LINK, b, a)),
+		as->add_link(EVALUATION_LINK,
+			as->add_node(PREDICATE_NODE, "p-" + std::to_string(r)),
+			as->add_link(LIST_LINK, a, b)));
+}
+
+typedef Handle (*Maker)(AtomSpace*, size_t, size_t);
+
+static void run(const char* name, const Params& p, Maker make)
+{
+	AtomSpacePtr asp(createAtomSpace());
+	AtomSpace* as = asp.get();
+
+	// Copy `k` of every rule uses the variables named `$a-k`, `$b-k`
+	// and so on. The copies are interleaved, so that the AtomSpace is
+	// growing the whole time, as it would when rules are generated.
+	std::set<Handle> distinct;
+	size_t total = p.nrules * p.ncopies;
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < total; i++)
+		distinct.insert(make(as, i % p.nrules, i / p.nrules));
+	double secs = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+
+	// Each rule should have been added once, and there should be
+	// (almost) no two rules with the same hash.
+	std::set<ContentHash> hashes;
+	for (const Handle& h : distinct) hashes.insert(h->get_hash());
+
+	printf("%-8s %9zu  %9zu  %9zu  %10.3f  %10.3f\n",
+	       name, total, distinct.size(), distinct.size() - hashes.size(),
+	       secs, 1.0e6 * secs / total);
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [rules [copies]]\n", argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.nrules = 250000;
+	p.ncopies = 4;
+	if (1 < argc) p.nrules = atol(argv[1]);
+	if (2 < argc) p.ncopies = atol(argv[2]);
+
+	printf("%-8s %9s  %9s  %9s  %10s  %10s\n",
+	       "rule", "inserts", "distinct", "collide", "seconds", "usec/rule");
+	run("lambda", p, lambda_rule);
+	run("query", p, query_rule);
+	return 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * tests/benchmark/transient_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Allocation benchmark for short-lived Atoms, of the kind that the
+ * pattern matcher and beta reduction create and throw away. Each
+ * thread builds small Links, keeps the last few around, and drops
+ * the older ones. Compares plain `std::make_shared` against the slab
+ * allocator behind `make_atom` (see `SlabAllocator.h`).
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/base/Link.h>
+#include <opencog/atoms/base/Node.h>
+
+using namespace opencog;
+
+struct Params
+{
+	size_t live;
+	double seconds;
+};
+
+struct Malloced
+{
+	template<typename T, typename... Args>
+	static Handle make(Args&&... args)
+	{ return Handle(std::make_shared<T>(std::forward<Args>(args)...)); }
+};
+
+struct Slabbed
+{
+	template<typename T, typename... Args>
+	static Handle make(Args&&... args)
+	{ return Handle(make_atom<T>(std::forward<Args>(args)...)); }
+};
+
+template<typename MAKER>
+static double run(const char* name, const Params& p, size_t nthreads)
+{
+	std::atomic<bool> go(false);
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> total(0);
+
+	auto worker = [&]()
+	{
+		// A ring of live Links; each new one replaces the oldest.
+		HandleSeq ring(p.live);
+		size_t made = 0;
+		size_t slot = 0;
+		while (not go.load()) std::this_thread::yield();
+		while (not stop.load(std::memory_order_relaxed))
+		{
+			for (int k = 0; k < 256; k++)
+			{
+				Handle a(MAKER::template make<Node>(VARIABLE_NODE, "$x"));
+				Handle b(MAKER::template make<Node>(CONCEPT_NODE, "b"));
+				ring[slot] = MAKER::template make<Link>(
+					HandleSeq({a, b}), LIST_LINK);
+				if (++slot == p.live) slot = 0;
+			}
+			made += 3 * 256;
+		}
+		total += made;
+	};
+
+	std::vector<std::thread> thrs;
+	for (size_t t = 0; t < nthreads; t++)
+		thrs.push_back(std::thread(worker));
+
+	auto start = std::chrono::steady_clock::now();
+	go = true;
+	std::this_thread::sleep_for(std::chrono::duration<double>(p.seconds));
+	stop = true;
+	for (std::thread& t : thrs) t.join();
+	auto end = std::chrono::steady_clock::now();
+
+	double secs = std::chrono::duration<double>(end - start).count();
+	double mops = total / secs / 1.0e6;
+	printf("%-12s threads=%-3zu  %8.2f M atoms/sec\n", name, nthreads, mops);
+	return mops;
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [live-links [seconds [threads...]]]\n", argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.live = 1000;
+	p.seconds = 2.0;
+	if (1 < argc) p.live = atol(argv[1]);
+	if (2 < argc) p.seconds = atof(argv[2]);
+	if (0 == p.live) p.live = 1;
+
+	std::vector<size_t> nthreads({1, 4, 16});
+	if (3 < argc)
+	{
+		nthreads.clear();
+		for (int i = 3; i < argc; i++) nthreads.push_back(atol(argv[i]));
+	}
+
+#if not USE_SLAB_ALLOC
+	printf("Note: USE_SLAB_ALLOC is off; make_atom is make_shared.\n");
+#endif
+	printf("%zu live Links per thread\n", p.live);
+	for (size_t n : nthreads)
+	{
+		run<Malloced>("make_shared", p, n);
+		run<Slabbed>("make_atom", p, n);
+	}
+	return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * tests/benchmark/typeset_bm.cc
+ *
+ * Copyright (C) 2026 BrainyBlaze Dynamics, LLC
+ * SPDX-License-Identifier: AGPL-3.0-or-later
+ *
+ * Contention benchmark for the TypeIndex sets. Many threads look up
+ * Atoms (as `AtomSpace::add()` does, to find duplicates), while a few
+ * remove and re-insert them. Compares the sharded, shared_mutex
+ * LockedAtomSet against the lock-free ConcurrentAtomSet.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <opencog/atoms/base/Node.h>
+#include <opencog/atomspace/TypeIndex.h>
+
+using namespace opencog;
+
+// As many shards as a hot type gets, in the TypeIndex, on 8 cores.
+#define POOL_SIZE 8
+
+struct Params
+{
+	size_t nthreads;
+	size_t natoms;
+	size_t write_permille;
+	double seconds;
+};
+
+template<typename SET>
+static void do_find(const SET& s, const Handle& h, size_t& hits)
+{
+	std::shared_lock<std::shared_mutex> lck(s._mtx);
+	if (s.find_atom(h)) hits++;
+}
+
+static void do_find(const ConcurrentAtomSet& s, const Handle& h, size_t& hits)
+{
+	if (s.find_atom(h)) hits++;
+}
+
+template<typename SET>
+static double run(const char* name, const Params& p,
+                  const HandleSeq& atoms, const HandleSeq& probes)
+{
+	std::vector<SET> shards(POOL_SIZE);
+	for (const Handle& h : atoms)
+	{
+		SET& s(shards[h->get_hash() % POOL_SIZE]);
+		std::unique_lock<std::shared_mutex> lck(s._mtx);
+		s.insert_atom(h);
+	}
+
+	std::atomic<bool> go(false);
+	std::atomic<bool> stop(false);
+	std::atomic<size_t> total_ops(0);
+	std::atomic<size_t> total_hits(0);
+
+	auto worker = [&](size_t tid)
+	{
+		std::minstd_rand rng(tid + 1);
+		size_t ops = 0;
+		size_t hits = 0;
+		while (not go.load()) std::this_thread::yield();
+		while (not stop.load(std::memory_order_relaxed))
+		{
+			// Check the clock only now and then.
+			for (int k = 0; k < 256; k++)
+			{
+				size_t i = rng() % p.natoms;
+				SET& s(shards[atoms[i]->get_hash() % POOL_SIZE]);
+				if (rng() % 1000 < p.write_permille)
+				{
+					std::unique_lock<std::shared_mutex> lck(s._mtx);
+					s.erase(atoms[i]);
+					s.insert_atom(atoms[i]);
+				}
+				else
+					do_find(s, probes[i], hits);
+			}
+			ops += 256;
+		}
+		total_ops += ops;
+		total_hits += hits;
+	};
+
+	std::vector<std::thread> thrs;
+	for (size_t t = 0; t < p.nthreads; t++)
+		thrs.push_back(std::thread(worker, t));
+
+	auto start = std::chrono::steady_clock::now();
+	go = true;
+	std::this_thread::sleep_for(std::chrono::duration<double>(p.seconds));
+	stop = true;
+	for (std::thread& t : thrs) t.join();
+	auto end = std::chrono::steady_clock::now();
+
+	double secs = std::chrono::duration<double>(end - start).count();
+	double mops = total_ops / secs / 1.0e6;
+	printf("%-18s threads=%-3zu  %8.2f Mops/sec  (%.1f%% hits)\n",
+	       name, p.nthreads, mops,
+	       100.0 * total_hits / std::max((size_t) 1, total_ops.load()));
+	return mops;
+}
+
+int main(int argc, char* argv[])
+{
+	if (1 < argc and 0 == strcmp(argv[1], "-h"))
+	{
+		printf("Usage: %s [threads [atoms [writes-per-thousand [seconds]]]]\n",
+		       argv[0]);
+		return 0;
+	}
+
+	Params p;
+	p.nthreads = std::max(1U, std::thread::hardware_concurrency());
+	p.natoms = 100000;
+	p.write_permille = 5;
+	p.seconds = 2.0;
+	if (1 < argc) p.nthreads = atol(argv[1]);
+	if (2 < argc) p.natoms = atol(argv[2]);
+	if (3 < argc) p.write_permille = atol(argv[3]);
+	if (4 < argc) p.seconds = atof(argv[4]);
+
+	// The probes are distinct, but equal, Atoms; so the lookups
+	// compare content, just like `AtomSpace::add()` does.
+	HandleSeq atoms;
+	HandleSeq probes;
+	for (size_t i = 0; i < p.natoms; i++)
+	{
+		std::string name = "node " + std::to_string(i);
+		atoms.push_back(createNode(CONCEPT_NODE, name));
+		probes.push_back(createNode(CONCEPT_NODE, name));
+	}
+
+	printf("%zu atoms, %zu shards, %zu writes per thousand ops\n",
+	       p.natoms, (size_t) POOL_SIZE, p.write_permille);
+
+	// Scale up to the requested thread count.
+	Params q(p);
+	for (q.nthreads = 1; ; q.nthreads *= 2)
+	{
+		if (p.nthreads < q.nthreads) q.nthreads = p.nthreads;
+		double lk = run<LockedAtomSet>("LockedAtomSet", q, atoms, probes);
+		double lf = run<ConcurrentAtomSet>("ConcurrentAtomSet", q, atoms, probes);
+		printf("%-18s threads=%-3zu  %8.2fx\n\n", "speedup", q.nthreads, lf/lk);
+		if (p.nthreads <= q.nthreads) break;
+	}
+	return 0;
+}
@@ -0,0 +1,39 @@
+import unittest
+
+from opencog.type_constructors import *
+
+try:
+    import pyarrow
+except ImportError:
+    pyarrow = None
+
+
+class ArrowExportTest(unittest.TestCase):
+
+    def setUp(self):
+        self.space = AtomSpace()
+
+    def tearDown(self):
+        del self.space
+
+    def test_capsules(self):
+        schema, array = FloatValue([1.0, 2.0]).__arrow_c_array__()
+        self.assertIn('arrow_schema', repr(schema))
+        self.assertIn('arrow_array', repr(array))
+
+    def test_not_exportable(self):
+        with self.assertRaises(RuntimeError):
+            ConceptNode('foo').__arrow_c_array__()
+
+    @unittest.skipIf(pyarrow is None, "pyarrow is not installed")
+    def test_pyarrow(self):
+        floats = pyarrow.array(FloatValue([1.0, 2.5]))
+        self.assertEqual([1.0, 2.5], floats.to_pylist())
+
+        strs = pyarrow.array(StringValue(["a", "bc"]))
+        self.assertEqual(["a", "bc"], strs.to_pylist())
+
+        table = pyarrow.array(LinkValue([StringValue(["a", "b"]),
+                                         FloatValue([1.0, 2.0])]))
+        self.assertEqual([{'0': 'a', '1': 1.0}, {'0': 'b', '1': 2.0}],
+                         table.to_pylist())
@@ -1,5 +1,7 @@
+import array
 import unittest
 
+from opencog import atomspace
 from opencog.type_constructors import *
 
 
@@ -52,3 +54,24 @@ class BoolValueTest(unittest.TestCase):
         self.assertFalse(value.is_atom())
         self.assertFalse(value.is_link())
         self.assertTrue(value.is_a(types.Value))
+
+    def test_packed_words(self):
+        bits = [i % 3 == 0 for i in range(70)]
+        value = BoolValue(bits)
+        self.assertEqual(70, value.bit_count)
+        view = memoryview(value)
+        self.assertTrue(view.readonly)
+        self.assertEqual(2, len(view))
+        # Bit zero is the most significant bit of the first word.
+        self.assertEqual(1 << 63, view[0] & (1 << 63))
+
+        copy = atomspace.BoolValue.from_words(view, 70)
+        self.assertEqual(value, copy)
+        self.assertEqual(bits, copy.to_list())
+
+    def test_from_words_tail(self):
+        words = array.array('Q', [0xffffffffffffffff])
+        value = atomspace.BoolValue.from_words(words, 4)
+        self.assertEqual(BoolValue([True, True, True, True]), value)
+        with self.assertRaises(ValueError):
+            atomspace.BoolValue.from_words(words, 65)
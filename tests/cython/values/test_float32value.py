@@ -0,0 +1,47 @@
+import array
+import unittest
+
+from opencog import atomspace
+from opencog.type_constructors import *
+
+
+class Float32ValueTest(unittest.TestCase):
+
+    def setUp(self):
+        self.space = AtomSpace()
+
+    def tearDown(self):
+        del self.space
+
+    def test_create_list_value(self):
+        value = Float32Value([1.0, 2.0, 3.0])
+        self.assertTrue(value is not None)
+        self.assertEqual([1.0, 2.0, 3.0], value.to_list())
+
+    def test_value_equals(self):
+        self.assertEqual(Float32Value(1.5), Float32Value([1.5]))
+        self.assertNotEqual(Float32Value([1.0, 2.0]),
+                            Float32Value([2.0, 1.0]))
+
+    def test_add_value_to_atom(self):
+        atom = ConceptNode('foo')
+        key = PredicateNode('bar')
+        atom = self.space.set_value(atom, key, Float32Value([0.25, 0.5]))
+        self.assertEqual(Float32Value([0.25, 0.5]), atom.get_value(key))
+        self.assertEqual(types.Float32Value, atom.get_value(key).type)
+
+    def test_memoryview(self):
+        value = Float32Value([1.0, 2.0, 3.0])
+        view = memoryview(value)
+        self.assertTrue(view.readonly)
+        self.assertEqual('f', view.format)
+        self.assertEqual(4, view.itemsize)
+        self.assertEqual([1.0, 2.0, 3.0], view.tolist())
+
+    def test_create_from_buffer(self):
+        data = array.array('f', [0.25 * i for i in range(100)])
+        value = Float32Value(data)
+        self.assertEqual(data.tolist(), value.to_list())
+        self.assertEqual(value, atomspace.Float32Value.from_buffer(data))
+        with self.assertRaises(ValueError):
+            Float32Value(array.array('d', [1.0]))
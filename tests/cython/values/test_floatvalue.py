@@ -1,5 +1,7 @@
+import array
 import unittest
 
+from opencog import atomspace
 from opencog.type_constructors import *
 
 
@@ -51,3 +53,22 @@ class FloatValueTest(unittest.TestCase):
         self.assertFalse(value.is_atom())
         self.assertFalse(value.is_link())
         self.assertTrue(value.is_a(types.Value))
+
+    def test_memoryview(self):
+        value = FloatValue([1.0, 2.0, 3.0])
+        view = memoryview(value)
+        self.assertTrue(view.readonly)
+        self.assertEqual('d', view.format)
+        self.assertEqual((3,), view.shape)
+        self.assertEqual([1.0, 2.0, 3.0], view.tolist())
+        with self.assertRaises(TypeError):
+            view[0] = 4.0
+
+    def test_create_from_buffer(self):
+        data = array.array('d', [0.5 * i for i in range(100)])
+        value = FloatValue(data)
+        self.assertEqual(data.tolist(), value.to_list())
+        self.assertEqual(value, atomspace.FloatValue.from_buffer(data))
+        self.assertEqual(FloatValue([]), FloatValue(array.array('d')))
+        with self.assertRaises(ValueError):
+            FloatValue(array.array('i', [1, 2, 3]))
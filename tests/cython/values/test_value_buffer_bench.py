@@ -0,0 +1,60 @@
+import array
+import time
+import unittest
+
+from opencog import atomspace
+from opencog.type_constructors import *
+
+# Micro-benchmark: moving a large vector between python and a FloatValue
+# through lists, and through the buffer protocol. Run with `pytest -s`
+# to see the timings.
+
+SIZE = 1000000
+
+
+def best_of(fn, runs=5):
+    best = None
+    for i in range(runs):
+        start = time.perf_counter()
+        fn()
+        secs = time.perf_counter() - start
+        if best is None or secs < best:
+            best = secs
+    return best
+
+
+class ValueBufferBench(unittest.TestCase):
+
+    def test_float_value(self):
+        data = array.array('d', [0.001 * i for i in range(SIZE)])
+        plain = data.tolist()
+        value = FloatValue(data)
+
+        t_list_in = best_of(lambda: FloatValue(plain))
+        t_buf_in = best_of(lambda: atomspace.FloatValue.from_buffer(data))
+        t_list_out = best_of(lambda: value.to_list())
+        t_buf_out = best_of(lambda: memoryview(value))
+
+        print("\nFloatValue, %d doubles" % SIZE)
+        print("  from list   %8.3f ms   from buffer %8.3f ms" %
+              (1000 * t_list_in, 1000 * t_buf_in))
+        print("  to_list     %8.3f ms   memoryview  %8.3f ms" %
+              (1000 * t_list_out, 1000 * t_buf_out))
+
+        # The view is not a copy; getting one does not depend on size.
+        self.assertLess(t_buf_out, t_list_out)
+        self.assertEqual(memoryview(value).tolist(), plain)
+
+    def test_bool_value(self):
+        words = array.array('Q', [0x5555555555555555] * (SIZE // 64))
+        value = atomspace.BoolValue.from_words(words, SIZE)
+
+        t_list_out = best_of(lambda: value.to_list())
+        t_buf_out = best_of(lambda: memoryview(value))
+
+        print("\nBoolValue, %d bits" % SIZE)
+        print("  to_list     %8.3f ms   memoryview  %8.3f ms" %
+              (1000 * t_list_out, 1000 * t_buf_out))
+
+        self.assertLess(t_buf_out, t_list_out)
+        self.assertEqual(bytes(memoryview(value)), bytes(words))